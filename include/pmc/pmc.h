@@ -23,6 +23,7 @@
 #include "pmc_headers.h"
 #include "pmc_input.h"
 #include "pmc_utils.h"
+#include "pmc_builder.h"
 
 #include "pmc_heu.h"
 #include "pmc_maxclique.h"
@@ -0,0 +1,99 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_BIT_MATRIX_H_
+#define PMC_BIT_MATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace pmc {
+
+    /// Dense adjacency matrix with one bit per entry.
+    ///
+    /// All rows live in one 64-byte aligned block and each row is padded to a
+    /// multiple of 64 bytes, so a row starts on its own cache line. Bits are
+    /// cleared with an atomic and, since the search threads prune vertices out
+    /// of shared words concurrently; set() is only for filling a row.
+    class bit_matrix {
+        private:
+            uint64_t* bits;
+            int n;
+            std::size_t words;      // per row
+
+            static uint64_t* allocate(std::size_t count) {
+                if (count == 0)  return nullptr;
+                void* p = std::aligned_alloc(64, count * sizeof(uint64_t));
+                if (p == nullptr)  throw std::bad_alloc();
+                return static_cast<uint64_t*>(p);
+            }
+
+        public:
+            bit_matrix() noexcept : bits(nullptr), n(0), words(0) {}
+            // n x n, all entries cleared
+            explicit bit_matrix(int size) : bits(nullptr), n(0), words(0) { resize(size); }
+            bit_matrix(const bit_matrix& other) : bits(allocate(other.n * other.words)), n(other.n), words(other.words) {
+                if (bits != nullptr)  std::memcpy(bits, other.bits, n * words * sizeof(uint64_t));
+            }
+            bit_matrix(bit_matrix&& other) noexcept : bits(other.bits), n(other.n), words(other.words) {
+                other.bits = nullptr;  other.n = 0;  other.words = 0;
+            }
+            bit_matrix& operator=(bit_matrix other) noexcept {
+                std::swap(bits, other.bits);
+                std::swap(n, other.n);
+                std::swap(words, other.words);
+                return *this;
+            }
+            ~bit_matrix() { std::free(bits); }
+
+            // rows are zeroed in parallel, so each thread first touches the rows it fills
+            void resize(int size) {
+                std::free(bits);
+                n = size;
+                words = ((static_cast<std::size_t>(size) + 511) / 512) * 8;
+                bits = allocate(n * words);
+                #pragma omp parallel for schedule(static)
+                for (int u = 0; u < n; u++)  std::memset(row(u), 0, words * sizeof(uint64_t));
+            }
+
+            int size() const noexcept { return n; }
+            bool empty() const noexcept { return n == 0; }
+            std::size_t words_per_row() const noexcept { return words; }
+            std::size_t size_bytes() const noexcept { return n * words * sizeof(uint64_t); }
+
+            uint64_t* row(int u) noexcept { return bits + u * words; }
+            const uint64_t* row(int u) const noexcept { return bits + u * words; }
+
+            bool test(int u, int v) const noexcept {
+                return (__atomic_load_n(&row(u)[v >> 6], __ATOMIC_RELAXED) >> (v & 63)) & 1;
+            }
+            void set(int u, int v) noexcept {
+                row(u)[v >> 6] |= uint64_t(1) << (v & 63);
+            }
+            void reset(int u, int v) noexcept {
+                __atomic_fetch_and(&row(u)[v >> 6], ~(uint64_t(1) << (v & 63)), __ATOMIC_RELAXED);
+            }
+    };
+
+}
+#endif
@@ -0,0 +1,190 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_BITSET_SOLVER_H_
+#define PMC_BITSET_SOLVER_H_
+
+#include "pmc/pmc_bool_vector.h"
+#include "pmc_vertex.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace pmc {
+
+    /// Maximum clique of one root neighborhood over a local bit matrix (BBMC).
+    ///
+    /// The candidates P of a root are renamed 0..|P|-1 and their induced
+    /// adjacency is kept as rows of 64-bit words. Neighborhood cores, greedy
+    /// coloring and the candidate sets of the branches are then and/andnot and
+    /// popcount over those rows, instead of scatters into ind[] over the global
+    /// neighbor lists. One solver per thread, it keeps its buffers between roots.
+    class bitset_solver {
+        private:
+            std::vector<int> local;         // global id -> local id, -1 outside P
+            std::vector<int> ids;           // local id -> global id
+            std::vector<uint64_t> rows, tmp;
+            std::vector<uint64_t> alive;    // candidates whose k-core bound still beats mc
+            std::vector<uint64_t> U, Q;
+            std::vector<uint64_t> sets;     // candidate set of each depth
+            std::vector< std::vector<int> > order, color;
+            std::vector<int> C, C_global;
+            std::vector<int> deg, core, pos, vert, bin, rename;   // scratch of reorder()
+            int p, words, alive_mc;
+
+            uint64_t* row(int i) noexcept { return rows.data() + (std::size_t)i * words; }
+            uint64_t* level(int d) {
+                if (sets.size() < (std::size_t)(d + 1) * words)  sets.resize((std::size_t)(d + 1) * words);
+                return sets.data() + (std::size_t)d * words;
+            }
+
+            static void set_bit(uint64_t* r, int j) noexcept { r[j >> 6] |= uint64_t(1) << (j & 63); }
+            static void clear_bit(uint64_t* r, int j) noexcept { r[j >> 6] &= ~(uint64_t(1) << (j & 63)); }
+
+            // local k-cores: drops the vertices of core < mc and renames the rest
+            // by decreasing core, so the coloring starts from the densest part
+            bool reorder(int mc);
+            void refresh_alive(const std::vector<int>& bound, const bool_vector& pruned, int mc);
+
+            template <class Found>
+            void expand(int depth, const std::vector<int>& bound, const bool_vector& pruned,
+                    const int& mc, const bool& go_on, Found& found);
+
+        public:
+            bitset_solver() : p(0), words(0), alive_mc(-1) {}
+            explicit bitset_solver(int n) : local(n, -1), p(0), words(0), alive_mc(-1) {}
+
+            // Searches the cliques of P larger than mc. found(C) is called with
+            // the global ids of each such clique, mc is reread as it grows and
+            // the search stops once go_on is false.
+            template <class Adjacency, class Found>
+            void solve(const Adjacency& A, const std::vector<Vertex>& P,
+                    const std::vector<int>& bound, const bool_vector& pruned,
+                    const int& mc, const bool& go_on, Found found);
+    };
+
+
+    template <class Adjacency, class Found>
+    void bitset_solver::solve(const Adjacency& A, const std::vector<Vertex>& P,
+            const std::vector<int>& bound, const bool_vector& pruned,
+            const int& mc, const bool& go_on, Found found) {
+
+        p = P.size();
+        words = (p + 63) / 64;
+        ids.resize(p);
+        for (int i = 0; i < p; i++) {
+            ids[i] = P[i].get_id();
+            local[ids[i]] = i;
+        }
+
+        rows.assign((std::size_t)p * words, 0);
+        for (int i = 0; i < p; i++) {
+            uint64_t* r = row(i);
+            for (int w : A.neighbors(ids[i])) {
+                const int j = local[w];
+                if (j >= 0)  set_bit(r, j);
+            }
+        }
+        for (int i = 0; i < p; i++)  local[ids[i]] = -1;
+
+        if (!reorder(mc))  return;
+
+        alive_mc = -1;
+        refresh_alive(bound, pruned, mc);
+        uint64_t* S = level(0);
+        for (int k = 0; k < words; k++)  S[k] = alive[k];
+        C.clear();
+        expand(0, bound, pruned, mc, go_on, found);
+    }
+
+
+    /**
+     * Branches on the vertices of the set at depth, from the highest color down
+     *   + greedy coloring: each color class takes the first remaining vertex and
+     *     drops its neighbors from the class, one word at a time
+     *   + only the vertices whose color can lift C above mc are branched on
+     */
+    template <class Found>
+    void bitset_solver::expand(int depth, const std::vector<int>& bound, const bool_vector& pruned,
+            const int& mc, const bool& go_on, Found& found) {
+
+        if ((int)order.size() <= depth) {
+            order.resize(depth + 1);
+            color.resize(depth + 1);
+        }
+        std::vector<int>& ord = order[depth];
+        std::vector<int>& col = color[depth];
+        ord.clear();  col.clear();
+
+        uint64_t* S = level(depth);
+        U.assign(S, S + words);
+        Q.resize(words);
+        int kmin = mc - (int)C.size() + 1;
+        if (kmin < 1)  kmin = 1;
+
+        int k = 0, first = 0;
+        while (true) {
+            while (first < words && U[first] == 0)  first++;
+            if (first == words)  break;
+            k++;
+            for (int w = first; w < words; w++)  Q[w] = U[w];
+            for (int w = first; w < words; w++) {
+                while (Q[w]) {
+                    const int v = (w << 6) + __builtin_ctzll(Q[w]);
+                    Q[w] &= Q[w] - 1;
+                    U[w] &= ~(uint64_t(1) << (v & 63));
+                    const uint64_t* r = row(v);
+                    for (int x = w; x < words; x++)  Q[x] &= ~r[x];
+                    if (k >= kmin) {
+                        ord.push_back(v);
+                        col.push_back(k);
+                    }
+                }
+            }
+        }
+
+        // deeper levels may grow order and color, so index them again from here
+        for (int i = (int)ord.size() - 1; i >= 0; i--) {
+            if (!go_on || (int)C.size() + color[depth][i] <= mc)  return;
+            if (alive_mc != mc)  refresh_alive(bound, pruned, mc);
+
+            const int v = order[depth][i];
+            C.push_back(v);
+            uint64_t* R = level(depth + 1);
+            S = level(depth);
+            const uint64_t* r = row(v);
+            uint64_t any = 0;
+            for (int w = 0; w < words; w++) {
+                R[w] = S[w] & r[w] & alive[w];
+                any |= R[w];
+            }
+
+            if (any)  expand(depth + 1, bound, pruned, mc, go_on, found);
+            else if ((int)C.size() > mc) {
+                C_global.resize(C.size());
+                for (std::size_t j = 0; j < C.size(); j++)  C_global[j] = ids[C[j]];
+                found(C_global);
+            }
+            C.pop_back();
+            clear_bit(level(depth), v);
+        }
+    }
+
+}
+#endif
@@ -0,0 +1,92 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_BOUND_REFRESH_H_
+#define PMC_BOUND_REFRESH_H_
+
+#include "pmc/pmc_bool_vector.h"
+#include "pmc/pmc_core_maintenance.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pmc {
+    class pmc_graph;
+
+    /// K-core bounds refreshed by a background thread while the search runs.
+    ///
+    /// The bounds are published as immutable arrays (RCU style): a searcher
+    /// takes the current array with acquire() and keeps it for a whole root,
+    /// while the refresh thread removes the pruned vertices from its own
+    /// core_maintenance, writes the next array into a new buffer and swaps the
+    /// pointer. Arrays are never written after they are published and are freed
+    /// with the last searcher holding them, so searchers never see a partial
+    /// update. request() only wakes the refresh thread, the root loop never
+    /// waits for a refresh.
+    class bound_refresh {
+        public:
+            typedef std::shared_ptr<const std::vector<int>> snapshot;
+
+            // starts from the k-cores of G, which must not change until stop(), and
+            // the vertices already set in pruned
+            bound_refresh(pmc_graph& G, const bool_vector& pruned);
+            ~bound_refresh();
+
+            snapshot acquire() const { return std::atomic_load(&current); }
+            // v was pruned (set in pruned) by a searcher, the next refresh removes it
+            void prune(int v) {
+                std::lock_guard<std::mutex> guard(pruned_lock);
+                newly_pruned.push_back(v);
+            }
+            void request();
+            // joins the refresh thread and copies the last bounds, published or
+            // not, back to G
+            void stop();
+
+        private:
+            pmc_graph& G;
+            std::unique_ptr<core_maintenance> cores;
+
+            snapshot current;
+            // the bounds of current, read back by stop()
+            std::shared_ptr<const std::vector<int>> front;
+            // vertices pruned before the search or passed to prune() since the last refresh
+            std::mutex pruned_lock;
+            std::vector<int> newly_pruned;
+            // vertices whose bound changed after front was published
+            std::vector<int> unpublished;
+            std::vector<char> is_unpublished;
+
+            std::thread worker;
+            std::mutex lock;
+            std::condition_variable wake;
+            bool pending;
+            bool done;
+            int refreshes;
+
+            void run();
+            void refresh();
+            int bound(int v) const { return cores->is_removed(v) ? 0 : cores->core_number(v) + 1; }
+    };
+
+}
+#endif
@@ -0,0 +1,111 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_BUILDER_H_
+#define PMC_BUILDER_H_
+
+#include "pmc/pmc_span.h"
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace pmc {
+
+    // in-place inclusive prefix sum, each thread scans one block
+    void prefix_sum(std::vector<long long>& a);
+
+    // canonical CSR over n vertices from lists of (v, u) pairs: parallel degree
+    // histogram, prefix sum and scatter. Every edge is stored in both directions,
+    // each neighbor list is sorted, repeated edges and self-loops are dropped.
+    // offset is subtracted from every id. Returns the number of repeated edges.
+    long long build_csr(int n, const std::vector<const std::vector<int>*>& pairs, int offset,
+            std::vector<long long>& vertices, std::vector<int>& edges);
+
+    // makes an arbitrary CSR canonical as above: the lists are mirrored where an
+    // edge is stored in one direction only, sorted and deduplicated
+    void canonicalize_csr(std::vector<long long>& vertices, std::vector<int>& edges);
+    // true if the CSR is already canonical and can be used as is
+    bool is_canonical_csr(span<const long long> vertices, span<const int> edges);
+
+
+    /// Edges added by a single thread, see graph_builder::get_buffer().
+    class edge_buffer {
+        friend class graph_builder;
+        private:
+            std::vector<int> pairs;
+            int max_id;
+
+        public:
+            edge_buffer() : max_id(-1) {}
+
+            void reserve(std::size_t m) { pairs.reserve(2 * m); }
+            // undirected edge {v, u}, ids are 0-based
+            void add_edge(int v, int u) {
+                pairs.push_back(v);
+                pairs.push_back(u);
+                if (v > max_id)  max_id = v;
+                if (u > max_id)  max_id = u;
+            }
+            std::size_t size() const noexcept { return pairs.size() / 2; }
+    };
+
+    /// Collects undirected edges from several threads and builds the CSR once.
+    ///
+    /// Each thread adds to its own buffer, so adding edges never synchronizes;
+    /// finalize() then builds the CSR in parallel from all buffers:
+    ///
+    ///     graph_builder builder;
+    ///     #pragma omp parallel
+    ///     {
+    ///         edge_buffer& buf = builder.get_buffer();
+    ///         #pragma omp for
+    ///         for (long long i = 0; i < m; i++)  buf.add_edge(ei[i], ej[i]);
+    ///     }
+    ///     pmc_graph G(builder);
+    class graph_builder {
+        private:
+            std::mutex lock;
+            std::deque<edge_buffer> buffers;    // references stay valid as buffers are added
+            int n;
+            long long duplicates;
+
+        public:
+            // the number of vertices grows to cover the largest id added
+            explicit graph_builder(int num_vertices = 0) : n(num_vertices), duplicates(0) {}
+
+            graph_builder(const graph_builder&) = delete;
+            graph_builder& operator=(const graph_builder&) = delete;
+
+            /// new buffer for the calling thread, safe to call concurrently
+            edge_buffer& get_buffer();
+
+            // totals over all buffers, not to be called while edges are added
+            int num_vertices() const;
+            long long num_edges() const;
+
+            /// builds the canonical CSR (see build_csr) and releases the buffers
+            void finalize(std::vector<long long>& vertices, std::vector<int>& edges);
+            // edges added more than once, known after finalize()
+            long long num_duplicates() const noexcept { return duplicates; }
+    };
+
+}
+#endif
@@ -0,0 +1,136 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_COMPRESSED_CSR_H_
+#define PMC_COMPRESSED_CSR_H_
+
+#include "pmc/pmc_span.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pmc {
+
+    // LEB128 varint, gaps of sorted neighbor lists almost always fit in one byte
+    static inline uint32_t read_varint(const uint8_t*& p) {
+        uint32_t x = p[0];
+        if (x < 0x80) { p += 1; return x; }
+        x = (x & 0x7f) | (uint32_t)p[1] << 7;
+        if (p[1] < 0x80) { p += 2; return x; }
+        x = (x & 0x3fff) | (uint32_t)p[2] << 14;
+        if (p[2] < 0x80) { p += 3; return x; }
+        x = (x & 0x1fffff) | (uint32_t)p[3] << 21;
+        if (p[3] < 0x80) { p += 4; return x; }
+        x = (x & 0xfffffff) | (uint32_t)p[4] << 28;
+        p += 5;
+        return x;
+    }
+
+    /// Neighbor lists stored as gaps in variable length bytes.
+    ///
+    /// The list of v is encoded as its degree, the first neighbor relative to
+    /// v (zigzag, so small for locality preserving orderings) and then the gaps
+    /// between consecutive sorted neighbors. Lists are decoded on the fly by
+    /// neighbor_iterator, so the search routines iterate over it exactly like
+    /// over a span of the plain CSR (see csr_adjacency).
+    class compressed_csr {
+        private:
+            std::vector<long long> offsets;     // byte offset of each list
+            std::vector<uint8_t> data;
+
+        public:
+            class neighbor_iterator {
+                private:
+                    const uint8_t* p;
+                    int left;
+                    int cur;
+                public:
+                    neighbor_iterator(const uint8_t* data, int count, int first)
+                        : p(data), left(count), cur(first) {}
+
+                    int operator*() const noexcept { return cur; }
+                    neighbor_iterator& operator++() {
+                        if (--left > 0)  cur += read_varint(p);
+                        return *this;
+                    }
+                    bool operator!=(const neighbor_iterator& other) const noexcept { return left != other.left; }
+                    bool operator==(const neighbor_iterator& other) const noexcept { return left == other.left; }
+            };
+
+            class neighbor_range {
+                private:
+                    neighbor_iterator first;
+                public:
+                    neighbor_range(const uint8_t* data, int count, int v) : first(data, count, 0) {
+                        if (count > 0) {
+                            uint32_t z = read_varint(data);
+                            first = neighbor_iterator(data, count, v + (int)((z >> 1) ^ (0u - (z & 1))));
+                        }
+                    }
+                    neighbor_iterator begin() const noexcept { return first; }
+                    neighbor_iterator end() const noexcept { return neighbor_iterator(nullptr, 0, 0); }
+            };
+
+            compressed_csr() {}
+            compressed_csr(const csr_array<long long>& vs, const csr_array<int>& es);
+
+            int num_vertices() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+            int degree(int v) const noexcept {
+                const uint8_t* p = data.data() + offsets[v];
+                return read_varint(p);
+            }
+
+            neighbor_range neighbors(int v) const noexcept {
+                const uint8_t* p = data.data() + offsets[v];
+                int d = read_varint(p);
+                return neighbor_range(p, d, v);
+            }
+
+            // bytes of the encoded lists, and including their offsets
+            std::size_t list_bytes() const noexcept { return data.size(); }
+            std::size_t size_bytes() const noexcept {
+                return data.size() + offsets.size() * sizeof(long long);
+            }
+    };
+
+
+    /// The plain CSR behind the same interface as compressed_csr.
+    ///
+    /// Offset is the width of the offsets, 64-bit in general and 32-bit when
+    /// the search runs on a graph with fewer than 2^32 stored edges.
+    template <class Offset>
+    struct basic_csr_adjacency {
+        const csr_array<Offset>& vs;
+        const csr_array<int>& es;
+
+        basic_csr_adjacency(const csr_array<Offset>& vertices, const csr_array<int>& edges)
+            : vs(vertices), es(edges) {}
+
+        int degree(int v) const noexcept { return static_cast<int>(vs[v + 1] - vs[v]); }
+        span<const int> neighbors(int v) const noexcept {
+            return span<const int>(es.data() + vs[v], vs[v + 1] - vs[v]);
+        }
+    };
+
+    typedef basic_csr_adjacency<long long> csr_adjacency;
+
+}
+#endif
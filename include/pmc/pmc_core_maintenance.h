@@ -0,0 +1,116 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_CORE_MAINTENANCE_H_
+#define PMC_CORE_MAINTENANCE_H_
+
+#include "pmc/pmc_span.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace pmc {
+
+    /// Core numbers kept exact while a graph changes.
+    ///
+    /// Starts from a CSR and an upper bound on its cores (kcore[v] = core+1, as
+    /// in pmc_graph, e.g. the cores of a supergraph) and then follows vertex
+    /// removals and edge insertions and deletions. Each vertex keeps mcd(v), the
+    /// number of its neighbors with a core number at least its own. An update
+    /// only visits the vertices around the change whose core can move: removals
+    /// lower cores while mcd(v) < core(v), an insertion raises the vertices of
+    /// core K reachable from the new edge through vertices of core K that keep
+    /// more than K neighbors in the (K+1)-core.
+    ///
+    /// The CSR is borrowed and must not change while the cores are maintained,
+    /// inserted and deleted edges are kept on the side.
+    class core_maintenance {
+        private:
+            csr_array<long long> vs;
+            csr_array<int> es;
+            std::vector<int> core;
+            std::vector<int> mcd;
+            std::vector<char> removed;
+            std::vector<long long> count;       // vertices per core number
+            int kmax;
+
+            std::unordered_map<int, std::vector<int>> added;
+            std::unordered_set<long long> deleted;
+
+            // scratch of the updates, reset only where it was used
+            std::vector<int> stamp;
+            int cur_stamp;
+            std::vector<int> cd;
+            std::vector<int> queue;
+            std::vector<char> queued;
+            std::vector<int> changed_vertices;
+            std::vector<char> is_changed;
+
+            static long long edge_key(int u, int v) noexcept {
+                return u < v ? ((long long)u << 32) | (unsigned)v : ((long long)v << 32) | (unsigned)u;
+            }
+
+            template <class F>
+            void for_each_neighbor(int v, F f) const {
+                const bool any_deleted = !deleted.empty();
+                for (long long j = vs[v]; j < vs[v + 1]; j++) {
+                    const int u = es[j];
+                    if (removed[u])  continue;
+                    if (any_deleted && deleted.count(edge_key(u, v)))  continue;
+                    f(u);
+                }
+                auto it = added.find(v);
+                if (it != added.end())
+                    for (int u : it->second)
+                        if (!removed[u])  f(u);
+            }
+
+            bool in_csr(int u, int v) const;
+            int next_stamp();
+            void set_core(int v, int k);
+            void push(int v);
+            void lower_cores();
+
+        public:
+            core_maintenance(
+                    const csr_array<long long>& vertices,
+                    const csr_array<int>& edges,
+                    const std::vector<int>& kcore);
+
+            int num_vertices() const noexcept { return core.size(); }
+            int core_number(int v) const noexcept { return core[v]; }
+            int max_core();
+            bool is_removed(int v) const noexcept { return removed[v]; }
+            bool has_edge(int u, int v) const;
+
+            // each returns false if the graph is unchanged
+            bool remove_vertex(int v);
+            bool insert_edge(int u, int v);
+            bool remove_edge(int u, int v);
+            // removes the vertices of V at once, with a single propagation
+            void remove_vertices(const std::vector<int>& V);
+
+            // vertices whose core number changed or that were removed since the
+            // last call, each listed once
+            void take_changed(std::vector<int>& V);
+    };
+
+}
+#endif
@@ -20,65 +20,168 @@
 #ifndef PMC_GRAPH_H_
 #define PMC_GRAPH_H_
 
+#include "pmc/pmc_bit_matrix.h"
 #include "pmc/pmc_bool_vector.h"
+#include "pmc/pmc_compressed_csr.h"
+#include "pmc/pmc_core_maintenance.h"
+#include "pmc/pmc_span.h"
 #include "pmc_vertex.h"
 
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace pmc {
+    class mapped_file;
+    class graph_builder;
+
+    // marks a CSR the caller has already checked with is_canonical_csr
+    struct canonical_csr_t {};
+
     class pmc_graph {
         private:
+            // keeps a mapped .pmcb file alive while the arrays borrow from it
+            std::shared_ptr<mapped_file> mapping;
+            // encoded neighbor lists, see compress_edges()
+            std::shared_ptr<const compressed_csr> compressed;
+            // cores followed by update_kcores(), dropped whenever the CSR or the cores are rebuilt
+            std::shared_ptr<core_maintenance> dynamic_cores;
+            // original id of each vertex after relabel(), empty if not relabeled
+            std::vector<int> labels;
+            // false when the file given to the constructor could not be read
+            bool loaded;
+
+            // Restricts the text readers to the edges between kept vertices, or with
+            // count_only makes them count the entries of each vertex instead of
+            // storing the edges. Ids are as in the file (0-based for .mtx).
+            struct edge_filter {
+                bool count_only = false;
+                std::vector<long long> degree;
+                std::vector<char> keep;
+            };
+
             // helper functions
-            void read_mtx(const std::string& filename);
-            void read_edges(const std::string& filename);
-            void read_metis(const std::string& /*filename*/) {}
+            void read_mtx(const std::string& filename, edge_filter* filter = nullptr);
+            void read_edges(const std::string& filename, edge_filter* filter = nullptr);
+            void read_metis(const std::string& filename);
+            void read_binary(const std::string& filename);
+            // checks the k-cores read from a snapshot against the CSR
+            bool valid_cores() const;
+            void build(graph_builder& builder);
+            // renames order[k] to k, vertices not in order are dropped
+            void permute(const std::vector<int>& order);
 
         public:
-            std::vector<int> edges;
-            std::vector<long long> vertices;
+            csr_array<int> edges;
+            csr_array<long long> vertices;
             std::vector<int> degree;
             int min_degree;
             int max_degree;
             double avg_degree;
             bool is_gstats;
             std::string fn;
-            std::vector<bool_vector> adj;
+            // the dense searches clear the edges of searched vertices in place and
+            // leave the matrix empty, then the next one builds it again
+            bit_matrix adj;
 
             // constructor
             pmc_graph(const std::string& filename);
-            pmc_graph(bool graph_stats, const std::string& filename);
+            // with lb > 2 the graph is loaded by read_graph(filename, lb)
+            pmc_graph(bool graph_stats, const std::string& filename, int lb = 0);
             pmc_graph(const std::string& filename, bool make_adj);
-            pmc_graph(std::vector<long long> vs, std::vector<int> es) {
-                edges = std::move(es);
-                vertices = std::move(vs);
-                vertex_degrees();
-            }
+            // the lists are made canonical (canonicalize_csr), the searches
+            // intersect them as sorted sets
+            pmc_graph(std::vector<long long> vs, std::vector<int> es);
+            // view over a CSR owned by the caller, which must outlive the graph.
+            // Nothing is copied unless the graph is reduced or the CSR is not
+            // canonical (is_canonical_csr), then a canonical copy is made.
+            pmc_graph(span<const long long> vs, span<const int> es);
+            // as above, without checking the CSR again
+            pmc_graph(span<const long long> vs, span<const int> es, canonical_csr_t);
             pmc_graph(long long nedges, const int *ei, const int *ej, int offset);
+            // finalizes the edges collected by builder
+            explicit pmc_graph(graph_builder& builder);
             pmc_graph(const std::map<int, std::vector<int>>& v_map);
 
             // destructor
             ~pmc_graph();
 
-            void read_graph(const std::string& filename);
+            // false if the file is missing, or its format or compression is not
+            // supported, the graph is then left empty
+            bool read_graph(const std::string& filename);
+            // Two-pass load for a known lower bound lb on the clique: the first pass
+            // only counts degrees, the second keeps the edges between vertices of
+            // degree >= lb-1, then peel() trims the rest. Only the (lb-1)-core is
+            // ever stored, and vertices keep their ids. Edge lists and .mtx only.
+            bool read_graph(const std::string& filename, int lb);
+            bool is_loaded() const noexcept { return loaded; }
+            // removes vertices of degree < d, repeatedly, leaving the d-core
+            void peel(int d);
+            bool save_binary(const std::string& filename) const;
             void create_adj();
             void reduce_graph(const bool_vector& pruned);
             void reduce_graph(
-                    std::vector<long long>& vs,
-                    std::vector<int>& es,
+                    csr_array<long long>& vs,
+                    csr_array<int>& es,
                     const bool_vector& pruned);
 
             int num_vertices() const noexcept { return vertices.size() - 1; }
-            int num_edges() const noexcept { return edges.size()/2; }
-            const std::vector <long long>& get_vertices() const noexcept { return vertices; }
-            const std::vector<int>& get_edges() const noexcept { return edges; }
+            long long num_edges() const noexcept { return vertices.empty() ? 0 : vertices.back()/2; }
+            const csr_array<long long>& get_vertices() const noexcept { return vertices; }
+            const csr_array<int>& get_edges() const noexcept { return edges; }
             std::vector<int>* get_degree(){ return &degree; }
-            std::vector<int> get_edges_array() { return edges; }
-            std::vector<long long> get_vertices_array() { return vertices; };
+            std::vector<int> get_edges_array() { return edges.to_vector(); }
+            std::vector<long long> get_vertices_array() { return vertices.to_vector(); };
+            // borrowed (zero-copy) views of the CSR arrays
+            csr_array<int> edges_view() const noexcept { return edges.view(); }
+            csr_array<long long> vertices_view() const noexcept { return vertices.view(); }
+
+            // The offsets are 64-bit, but the sparse searches of pmcx_maxclique and
+            // pmcx_maxclique_basic only need 32 bits while the graph has fewer than
+            // 2^32 stored edges (true for all but the largest inputs). Their threads
+            // then share one 32-bit copy and reduce to 32-bit copies. pmc_maxclique,
+            // pmc_heu and the dense searches always use the 64-bit offsets.
+            bool fits_narrow_offsets() const noexcept {
+                return vertices.empty() || vertices.back() <= static_cast<long long>(UINT32_MAX);
+            }
+            // offsets in the width the search runs with: a view, or a 32-bit copy
+            // built on each call, which the caller shares between its threads
+            void offsets(csr_array<long long>& vs) const { vs = vertices.view(); }
+            void offsets(csr_array<uint32_t>& vs) const;
             std::vector<long long> e_v, e_u, eid;
 
-            int vertex_degree(int v) const noexcept { return vertices[v] - vertices[v+1]; }
+            // encodes the neighbor lists (compressed_csr) for the sparse search of
+            // pmcx_maxclique. With release_edges the plain lists are freed, after which
+            // only the search over the compressed lists may use the graph.
+            void compress_edges(bool release_edges);
+            const compressed_csr* get_compressed_edges() const noexcept { return compressed.get(); }
+
+            // visits the neighbors of v from the plain or the compressed lists
+            template <class F>
+            void for_each_neighbor(int v, F f) const {
+                if (compressed != nullptr && edges.empty()) {
+                    for (int u : compressed->neighbors(v))  f(u);
+                }
+                else {
+                    for (long long j = vertices[v]; j < vertices[v + 1]; j++)  f(edges[j]);
+                }
+            }
+
+            // Renames the vertices in a locality preserving order, "kcore" (the
+            // degeneracy order of compute_cores) or "rcm" (reverse Cuthill-McKee),
+            // and rewrites the CSR and the k-cores to match. Call before create_adj().
+            // Cliques found afterwards use the new ids, original_ids() maps them back.
+            bool relabel(const std::string& ordering);
+            std::vector<int> original_ids(const std::vector<int>& C) const;
+            bool is_relabeled() const noexcept { return !labels.empty(); }
+            // Drops the vertices of k-core bound <= lb, which are in no clique larger
+            // than lb, and renames the rest 0..n-1 in their current order (labels as
+            // for relabel). Returns the number of vertices kept.
+            int compact(int lb);
+
+            int vertex_degree(int v) const noexcept { return static_cast<int>(vertices[v+1] - vertices[v]); }
             long long first_neigh(int v) const noexcept { return vertices[v]; }
             long long last_neigh(int v) const noexcept { return vertices[v+1]; }
 
@@ -100,7 +203,8 @@ namespace pmc {
             // vertex sorter
             void compute_ordering(std::vector<int>& bound, std::vector<int>& order);
             void compute_ordering(std::string degree, std::vector<int>& order);
-            // edge sorters
+            // edge sorters, the searches need the lists sorted by id: call
+            // canonicalize_csr on the arrays before searching a graph sorted here
             void degree_bucket_sort();
             void degree_bucket_sort(bool desc);
 
@@ -110,16 +214,29 @@ namespace pmc {
             std::vector<int>* get_kcores() { return &kcore; }
             std::vector<int>* get_kcore_ordering() { return &kcore_order; }
             int get_max_core() const noexcept { return max_core; }
+            bool has_cores() const noexcept { return !kcore.empty(); }
+            // incremental, the cost follows the pruned vertices and the cores they move
             void update_kcores(const bool_vector& pruned);
 
             void compute_cores();
+            // parallel peeling instead of the bin sort in compute_cores()
+            bool parallel_cores;
+            void compute_cores_parallel();
+            // Truss number of each edge slot (as in edges): the largest k such that
+            // the edge is in the k-truss, where every edge lies in k-2 triangles.
+            // Returns the largest, an upper bound on the clique size.
+            int compute_truss(std::vector<int>& truss) const;
+            // removes the edges of truss number < lb, which are in no clique of
+            // size >= lb, and recomputes the k-cores. Returns the max truss.
+            int truss_pruning(int lb);
+            template <class Offset>
             void induced_cores_ordering(
-                    std::vector<long long>& V,
-                    std::vector<int>& E);
+                    const csr_array<Offset>& V,
+                    const csr_array<int>& E);
 
             // clique utils
             int initial_pruning(pmc_graph& G, bool_vector& pruned, int lb);
-            int initial_pruning(pmc_graph& G, bool_vector& pruned, int lb, std::vector<bool_vector>& adj);
+            int initial_pruning(pmc_graph& G, bool_vector& pruned, int lb, bit_matrix& adj);
             void order_vertices(std::vector<Vertex> &V, pmc_graph &G,
                     int &lb_idx, int &lb, std::string vertex_ordering, bool decr_order);
 
@@ -129,9 +246,11 @@ namespace pmc {
                     double time_limit, bool &time_expired_msg);
             void graph_stats(pmc_graph& G, int& mc, int id, double &sec);
 
+            // Offset is long long or uint32_t, see fits_narrow_offsets()
+            template <class Offset>
             void reduce_graph(
-                    std::vector<long long>& vs,
-                    std::vector<int>& es,
+                    csr_array<Offset>& vs,
+                    csr_array<int>& es,
                     const bool_vector& pruned,
                     pmc_graph& G);
 
@@ -33,8 +33,8 @@ namespace pmc {
 
     class pmc_heu {
         public:
-            std::vector<int> const* E;
-            std::vector<long long> const* V;
+            csr_array<int> const* E;
+            csr_array<long long> const* V;
             std::vector<int>* K;
             std::vector<int>* order;
             std::vector<int>* degree;
@@ -82,7 +82,8 @@ namespace pmc {
             int search_cores(const pmc_graph& graph, std::vector<int>& C_max, int lb);
             int search_bounds(const pmc_graph& graph, std::vector<int>& C_max);
 
-            inline void branch(std::vector<Vertex>& P, int sz,
+            // Ps holds the ids of P in increasing order
+            inline void branch(std::vector<Vertex>& P, std::vector<int>& Ps, int sz,
                     int& mc, std::vector<int>& C, bool_vector& ind);
 
             void print_info(const std::vector<int>& C_max) const;
@@ -38,6 +38,8 @@ class input {
         int ub;
         int param_ub;
         int adj_limit;
+        int bitset_limit;
+        double bitset_density;
         double time_limit;
         double remove_time;
         bool graph_stats;
@@ -45,10 +47,15 @@ class input {
         bool help;
         bool MCE;
         bool decreasing_order;
+        bool compressed;
+        bool truss;
         std::string heu_strat;
         std::string format;
         std::string graph;
         std::string output;
+        std::string binary_out;
+        std::string relabel;
+        std::string cores;
         std::string edge_sorter;
         std::string vertex_search_order;
 
@@ -61,6 +68,8 @@ class input {
             ub = 0;
             param_ub = 0;
             adj_limit = 20000;
+            bitset_limit = 4096; 			// largest neighborhood searched over a local bit matrix
+            bitset_density = 0.05; 			// and its least density, unless it fits in one word
             time_limit = 60 * 60; 			// max time to search
             remove_time = 4.0; 				// time to wait before reducing graph
             verbose = false;
@@ -68,11 +77,16 @@ class input {
             help = false;
             MCE = false;
             decreasing_order = false;
+            compressed = false;
+            truss = false;
             heu_strat = "kcore";
             vertex_search_order = "deg";
             format = "mtx";
             graph = "data/sample.mtx";
             output = "";
+            binary_out = "";
+            relabel = "";
+            cores = "bz";
             std::string edge_sorter = "";
 
             // both off, use default alg
@@ -91,6 +105,8 @@ class input {
             ub = 0;
             param_ub = 0;
             adj_limit = 20000;
+            bitset_limit = 4096; 			// largest neighborhood searched over a local bit matrix
+            bitset_density = 0.05; 			// and its least density, unless it fits in one word
             time_limit = 60 * 60; 			// max time to search
             remove_time = 4.0; 				// time to wait before reducing graph
             verbose = false;
@@ -98,15 +114,20 @@ class input {
             help = false;
             MCE = false;
             decreasing_order = false;
+            compressed = false;
+            truss = false;
             heu_strat = "kcore";
             vertex_search_order = "deg";
             format = "mtx";
             graph = "data/sample.mtx";
             output = "";
+            binary_out = "";
+            relabel = "";
+            cores = "bz";
             std::string edge_sorter = "";
 
             int opt;
-            while ((opt=getopt(argc,argv,"i:t:f:u:l:o:e:a:r:w:h:k:dgsv")) != EOF) {
+            while ((opt=getopt(argc,argv,"i:t:f:u:l:o:e:a:r:w:h:k:b:p:m:B:D:cdgsTv")) != EOF) {
                 switch (opt) {
                     case 'a':
                         algorithm = atoi(optarg);
@@ -147,9 +168,30 @@ class input {
                     case 'e':
                         edge_sorter = optarg;
                         break;
+                    case 'b':
+                        binary_out = optarg;
+                        break;
+                    case 'p':
+                        relabel = optarg;
+                        break;
+                    case 'm':
+                        cores = optarg;
+                        break;
                     case 'o':
                         vertex_search_order = optarg;
                         break;
+                    case 'B':
+                        bitset_limit = atoi(optarg);
+                        break;
+                    case 'D':
+                        bitset_density = atof(optarg);
+                        break;
+                    case 'c':
+                        compressed = true;
+                        break;
+                    case 'T':
+                        truss = true;
+                        break;
                     case 'd':
                         // direction of which vertices are ordered
                         decreasing_order = true;
@@ -169,6 +211,11 @@ class input {
 
             if (threads <= 0) threads = 1;
 
+            if (cores != "bz" && cores != "pkc") {
+                std::cout << "unknown k-core method " << cores << ", using bz" << std::endl;
+                cores = "bz";
+            }
+
             if (!fexists(graph.c_str())) {
                 usage(argv[0]);
                 exit(-1);
@@ -0,0 +1,79 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_INTERSECT_H_
+#define PMC_INTERSECT_H_
+
+#include "pmc/pmc_compressed_csr.h"
+
+#include <vector>
+
+namespace pmc {
+
+    // Intersections of sorted, duplicate free id lists, such as the neighbor
+    // lists of the canonical CSR. Each kernel writes a ∩ b to out in increasing
+    // order and returns its size, out needs room for min(na, nb) ids.
+
+    // two cursors, one compare per step
+    int intersect_merge(const int* a, int na, const int* b, int nb, int* out);
+    // for na much smaller than nb: each id of a is found in b by doubling
+    // the step from the last match and a binary search
+    int intersect_gallop(const int* a, int na, const int* b, int nb, int* out);
+    // blocks of 4, 8 or 16 ids of a compared with as many of b and all their
+    // rotations, the smaller block maximum advances. Only built for x86, the
+    // CPU has to support the instructions (see best_intersect_kernel()).
+    int intersect_sse(const int* a, int na, const int* b, int nb, int* out);
+    int intersect_avx2(const int* a, int na, const int* b, int nb, int* out);
+    int intersect_avx512(const int* a, int na, const int* b, int nb, int* out);
+
+    enum intersect_kernel { INTERSECT_MERGE, INTERSECT_SSE, INTERSECT_AVX2, INTERSECT_AVX512 };
+    // widest block kernel of this CPU, from cpuid
+    intersect_kernel best_intersect_kernel();
+    const char* intersect_kernel_name(intersect_kernel k);
+
+    // galloping once one list is this many times longer than the other
+    static const int intersect_gallop_ratio = 16;
+
+    // galloping for skewed sizes, otherwise the SSE or AVX2 kernel as the CPU allows
+    int intersect_sorted(const int* a, int na, const int* b, int nb, int* out);
+
+
+    // Common neighbors of v and the sorted ids P, written to out (room for |P|).
+    template <class Offset>
+    inline int common_neighbors(const basic_csr_adjacency<Offset>& A, int v,
+            const std::vector<int>& P, int* out) {
+        span<const int> N = A.neighbors(v);
+        return intersect_sorted(P.data(), P.size(), N.data(), N.size(), out);
+    }
+
+    // the encoded lists are decoded once, in step with P
+    inline int common_neighbors(const compressed_csr& A, int v,
+            const std::vector<int>& P, int* out) {
+        int k = 0, i = 0;
+        const int n = P.size();
+        for (int w : A.neighbors(v)) {
+            while (i < n && P[i] < w)  i++;
+            if (i == n)  break;
+            if (P[i] == w)  out[k++] = w;
+        }
+        return k;
+    }
+
+}
+#endif
@@ -32,8 +32,8 @@ namespace pmc {
 
     class pmc_maxclique {
         public:
-            std::vector<int> const* edges;
-            std::vector<long long> const* vertices;
+            csr_array<int> const* edges;
+            csr_array<long long> const* vertices;
             std::vector<int>* bound;
             std::vector<int>* order;
             std::vector<int>* degree;
@@ -91,8 +91,10 @@ namespace pmc {
 
             int search(pmc_graph& G, std::vector<int>& sol);
 
+            // Ps holds the ids of P in increasing order, for the intersections
             void branch(
                     std::vector<Vertex> &P,
+                    std::vector<int>& Ps,
                     std::vector<short>& ind,
                     std::vector<int>& C,
                     std::vector<int>& C_max,
@@ -109,7 +111,7 @@ namespace pmc {
                     std::vector<int>& C_max,
                     bool_vector& pruned,
                     int& mc,
-                    std::vector<bool_vector>& adj);
+                    bit_matrix& adj);
 
     };
 };
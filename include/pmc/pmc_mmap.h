@@ -0,0 +1,59 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_MMAP_H_
+#define PMC_MMAP_H_
+
+#include <cstddef>
+#include <string>
+
+namespace pmc {
+
+    /// Read-only memory mapping of an entire file.
+    ///
+    /// The graph readers parse directly out of the mapping, so a file is
+    /// never copied into user space buffers before it is tokenized.
+    class mapped_file {
+        private:
+            const char* ptr;
+            std::size_t len;
+            bool is_mapped;
+
+        public:
+            mapped_file() : ptr(nullptr), len(0), is_mapped(false) {}
+            explicit mapped_file(const std::string& filename) : mapped_file() { open(filename); }
+            ~mapped_file() { close(); }
+
+            mapped_file(const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+
+            // sequential asks for aggressive readahead (MADV_SEQUENTIAL), for
+            // parsers that read the file once. Otherwise the default paging is
+            // kept, for arrays that are used in place.
+            bool open(const std::string& filename, bool sequential = true);
+            void close();
+
+            bool is_open() const noexcept { return is_mapped; }
+            const char* data() const noexcept { return ptr; }
+            const char* end() const noexcept { return ptr + len; }
+            std::size_t size() const noexcept { return len; }
+    };
+
+}
+#endif
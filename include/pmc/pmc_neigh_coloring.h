@@ -20,17 +20,21 @@
 #ifndef PMC_NEIGH_COLORING_H_
 #define PMC_NEIGH_COLORING_H_
 
+#include "pmc/pmc_bit_matrix.h"
 #include "pmc/pmc_bool_vector.h"
+#include "pmc/pmc_compressed_csr.h"
+#include "pmc/pmc_span.h"
 #include "pmc_vertex.h"
 
 #include <vector>
 
 namespace pmc {
 
-    // sequential dynamic greedy coloring and sort
+    // sequential dynamic greedy coloring and sort,
+    // Adjacency is basic_csr_adjacency or compressed_csr
+    template <class Adjacency>
     static void neigh_coloring_bound(
-            std::vector<long long>& vs,
-            std::vector<int>& es,
+            const Adjacency& A,
             std::vector<Vertex> &P,
             std::vector<short>& ind,
             std::vector<int>& C,
@@ -46,7 +50,7 @@ namespace pmc {
             u = P[w].get_id();
             k = 1, k_prev = 0;
 
-            for (long long h = vs[u]; h < vs[u + 1]; h++)  ind[es[h]] = 1;
+            for (int nb : A.neighbors(u))  ind[nb] = 1;
 
             while (k > k_prev) {
                 k_prev = k;
@@ -58,7 +62,7 @@ namespace pmc {
                 }
             }
 
-            for (long long h = vs[u]; h < vs[u + 1]; h++)  ind[es[h]] = 0;
+            for (int nb : A.neighbors(u))  ind[nb] = 0;
 
             if (k > max_k) {
                 max_k = k;
@@ -83,13 +87,24 @@ namespace pmc {
             }
     }
 
+    static void neigh_coloring_bound(
+            const csr_array<long long>& vs,
+            const csr_array<int>& es,
+            std::vector<Vertex> &P,
+            std::vector<short>& ind,
+            std::vector<int>& C,
+            std::vector< std::vector<int> >& colors,
+            int& mc) {
+        neigh_coloring_bound(csr_adjacency(vs, es), P, ind, C, colors, mc);
+    }
+
     // sequential dynamic greedy coloring and sort
     static void neigh_coloring_dense(
             std::vector<Vertex> &P,
             std::vector<int>& C,
             std::vector< std::vector<int> >& colors,
             int& mc,
-            const std::vector<bool_vector>& adj) {
+            const bit_matrix& adj) {
 
         int j = 0, u = 0, k = 1, k_prev = 0;
         int max_k = 1;
@@ -104,7 +119,7 @@ namespace pmc {
             while (k > k_prev) {
                 k_prev = k;
                 for (int i = 0; i < colors[k].size(); i++) { //use directly, sort makes it fast!
-                    if (adj[u][colors[k][i]]) {
+                    if (adj.test(u, colors[k][i])) {
                         k++;
                         break;
                     }
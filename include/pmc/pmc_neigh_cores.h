@@ -20,15 +20,18 @@
 #ifndef PMC_NEIGH_CORES_H_
 #define PMC_NEIGH_CORES_H_
 
+#include "pmc/pmc_compressed_csr.h"
+#include "pmc/pmc_span.h"
 #include "pmc_vertex.h"
 
 #include <vector>
 
 namespace pmc {
 
+    // Adjacency is basic_csr_adjacency or compressed_csr
+    template <class Adjacency>
     static void neigh_cores_bound(
-            std::vector<long long>& vs,
-            std::vector<int>& es,
+            const Adjacency& A,
             std::vector<Vertex> &P,
             std::vector<short>& ind,
             int& mc) {
@@ -49,8 +52,8 @@ namespace pmc {
         for (int v = 1; v < n; v++) { 	// for each v in P
             u = P[v-1].get_id();
             x = 0;
-            for (long long j=vs[u]; j<vs[u+1]; j++) { //induced degree
-                if (ind[es[j]]) x++;
+            for (int nb : A.neighbors(u)) { //induced degree
+                if (ind[nb]) x++;
             }
             deg[v] = x;
             if (deg[v] > md)  md = deg[v];
@@ -83,14 +86,13 @@ namespace pmc {
 
 
         int v_newid, v_actual, u_newid, du, pu, pw, w;
-        long long j = 0;
         for (int i = 1; i < n; i++) {  							// neighborhood K-cores
             v_newid = vert_order[i]; 							//relabeled id
             v_actual = newids_to_actual[v_newid]; 				// real id
-            for (j = vs[v_actual]; j<vs[v_actual+1]; j++) {
-                if (ind[es[j]] > 0) { 							// find common induced neighbors of k
+            for (int nb : A.neighbors(v_actual)) {
+                if (ind[nb] > 0) { 							// find common induced neighbors of k
 
-                    u_newid = ind[es[j]];
+                    u_newid = ind[nb];
                     if (deg[u_newid] > deg[v_newid]) {
                         du = deg[u_newid];
                         pu = pos[u_newid];
@@ -130,9 +132,19 @@ namespace pmc {
     }
 
 
+    static void neigh_cores_bound(
+            const csr_array<long long>& vs,
+            const csr_array<int>& es,
+            std::vector<Vertex> &P,
+            std::vector<short>& ind,
+            int& mc) {
+        neigh_cores_bound(csr_adjacency(vs, es), P, ind, mc);
+    }
+
+
     static void neigh_cores_tight(
-            std::vector<long long>& vs,
-            std::vector<int>& es,
+            const csr_array<long long>& vs,
+            const csr_array<int>& es,
             std::vector<Vertex> &P,
             std::vector<short>& ind,
             int& mc) {
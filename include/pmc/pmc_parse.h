@@ -0,0 +1,104 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_PARSE_H_
+#define PMC_PARSE_H_
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace pmc {
+
+    // position of the '\n' terminating the line that starts at p (or end)
+    static inline const char* line_end(const char* p, const char* end) {
+        const void* nl = std::memchr(p, '\n', end - p);
+        return nl ? static_cast<const char*>(nl) : end;
+    }
+
+    // first character of the line following p
+    static inline const char* next_line(const char* p, const char* end) {
+        const char* eol = line_end(p, end);
+        return eol < end ? eol + 1 : end;
+    }
+
+    static inline const char* skip_blanks(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))  p++;
+        return p;
+    }
+
+    // parse a (signed) decimal integer, leaves p after the last digit
+    static inline bool parse_int(const char*& p, const char* end, long long& value) {
+        p = skip_blanks(p, end);
+        bool neg = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            neg = (*p == '-');
+            p++;
+        }
+        if (p == end || *p < '0' || *p > '9')  return false;
+
+        long long x = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            x = x * 10 + (*p - '0');
+            p++;
+        }
+        value = neg ? -x : x;
+        return true;
+    }
+
+    // parse a floating point token, the mapped input is not null terminated
+    static inline bool parse_double(const char*& p, const char* end, double& value) {
+        p = skip_blanks(p, end);
+        char buf[64];
+        int len = 0;
+        while (p < end && len < 63 && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+            buf[len++] = *p++;
+        if (len == 0)  return false;
+        buf[len] = '\0';
+        value = std::strtod(buf, nullptr);
+        return true;
+    }
+
+    // split [begin, end) into at most nchunks ranges that start on a line
+    static std::vector<const char*> split_lines(const char* begin, const char* end, int nchunks) {
+        std::vector<const char*> bounds(1, begin);
+        if (nchunks < 1)  nchunks = 1;
+        size_t step = (end - begin) / nchunks + 1;
+
+        const char* p = begin;
+        while (p < end) {
+            const char* q = (size_t)(end - p) > step ? p + step : end;
+            if (q < end)  q = next_line(q, end);
+            bounds.push_back(q);
+            p = q;
+        }
+        if (bounds.size() == 1)  bounds.push_back(end);
+        return bounds;
+    }
+
+    // number of chunks to split an input of n bytes into for a parallel parse
+    static inline int num_parse_chunks(size_t n, int threads) {
+        const size_t min_chunk = 1 << 20;
+        size_t chunks = n / min_chunk + 1;
+        if (chunks > (size_t)threads * 8)  chunks = (size_t)threads * 8;
+        return static_cast<int>(chunks);
+    }
+}
+
+#endif
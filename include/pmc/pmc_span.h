@@ -0,0 +1,133 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_SPAN_H_
+#define PMC_SPAN_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace pmc {
+
+    /// Non-owning view of a contiguous array (a minimal std::span for C++17).
+    template <class T>
+    class span {
+        private:
+            T* ptr;
+            std::size_t len;
+
+        public:
+            span() noexcept : ptr(nullptr), len(0) {}
+            span(T* data, std::size_t size) noexcept : ptr(data), len(size) {}
+            template <class U>
+            span(const std::vector<U>& v) noexcept : ptr(v.data()), len(v.size()) {}
+
+            T* data() const noexcept { return ptr; }
+            std::size_t size() const noexcept { return len; }
+            bool empty() const noexcept { return len == 0; }
+            T& operator[](std::size_t i) const noexcept { return ptr[i]; }
+            T* begin() const noexcept { return ptr; }
+            T* end() const noexcept { return ptr + len; }
+    };
+
+
+    /// Read-only array of the CSR graph that either owns its elements or
+    /// borrows memory owned elsewhere (a caller's CSR, a mapped .pmcb file).
+    ///
+    /// Copying a borrowed array only copies the pointer, so per-thread copies
+    /// in the search routines are free until a thread reduces its graph. The
+    /// elements are never modified in place: a new array is always assigned
+    /// as a whole, which makes the array owning.
+    template <class T>
+    class csr_array {
+        private:
+            std::vector<T> store;
+            const T* ptr;
+            std::size_t len;
+            bool owned;
+
+            void own() noexcept {
+                ptr = store.data();
+                len = store.size();
+                owned = true;
+            }
+
+        public:
+            csr_array() noexcept : ptr(nullptr), len(0), owned(true) {}
+            csr_array(std::vector<T> v) : store(std::move(v)) { own(); }
+            csr_array(span<const T> v) noexcept : ptr(v.data()), len(v.size()), owned(false) {}
+
+            csr_array(const csr_array& other) : store(other.store) {
+                if (other.owned) own();
+                else {
+                    ptr = other.ptr;
+                    len = other.len;
+                    owned = false;
+                }
+            }
+
+            csr_array(csr_array&& other) noexcept
+                : store(std::move(other.store)), ptr(other.ptr), len(other.len), owned(other.owned) {
+                other.ptr = nullptr;
+                other.len = 0;
+                other.owned = true;
+            }
+
+            csr_array& operator=(const csr_array& other) {
+                if (this != &other) {
+                    csr_array tmp(other);
+                    *this = std::move(tmp);
+                }
+                return *this;
+            }
+
+            csr_array& operator=(csr_array&& other) noexcept {
+                store = std::move(other.store);
+                ptr = other.ptr;
+                len = other.len;
+                owned = other.owned;
+                other.ptr = nullptr;
+                other.len = 0;
+                other.owned = true;
+                return *this;
+            }
+
+            csr_array& operator=(std::vector<T> v) {
+                store = std::move(v);
+                own();
+                return *this;
+            }
+
+            /// borrowed view of this array, valid while this array is alive and not reassigned
+            csr_array view() const noexcept { return csr_array(span<const T>(ptr, len)); }
+            std::vector<T> to_vector() const { return std::vector<T>(ptr, ptr + len); }
+            bool owns() const noexcept { return owned; }
+
+            const T& operator[](std::size_t i) const noexcept { return ptr[i]; }
+            const T* data() const noexcept { return ptr; }
+            std::size_t size() const noexcept { return len; }
+            bool empty() const noexcept { return len == 0; }
+            const T& back() const noexcept { return ptr[len - 1]; }
+            const T* begin() const noexcept { return ptr; }
+            const T* end() const noexcept { return ptr + len; }
+    };
+
+}
+#endif
@@ -0,0 +1,85 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#ifndef PMC_STREAM_H_
+#define PMC_STREAM_H_
+
+#include "pmc/pmc_mmap.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pmc {
+
+    class stream_decoder;
+
+    /// Successive blocks of whole lines of a text graph file.
+    ///
+    /// Plain files are mapped and returned as a single block. Compressed files
+    /// (.gz, .zst, .xz) are decompressed by a background thread into a small
+    /// ring of fixed size buffers: the next block is decompressed while the
+    /// caller parses the current one, and memory stays bounded by the ring.
+    class line_reader {
+        private:
+            mapped_file file;
+            bool mapped_done;
+
+            std::unique_ptr<stream_decoder> decoder;
+            std::thread worker;
+            std::mutex lock;
+            std::condition_variable cond;
+            std::deque< std::vector<char> > full;     // decompressed blocks ready to parse
+            std::vector< std::vector<char> > free;    // recycled buffers
+            std::vector<char> current;                // block handed out by next()
+            bool finished;
+            bool cancelled;
+            bool failed;
+            std::size_t total;
+
+            void decompress();
+
+        public:
+            explicit line_reader(const std::string& filename);
+            ~line_reader();
+
+            line_reader(const line_reader&) = delete;
+            line_reader& operator=(const line_reader&) = delete;
+
+            bool is_open() const noexcept { return file.is_open() || decoder != nullptr; }
+            bool error() const noexcept { return failed; }
+            std::size_t bytes() const noexcept { return total; }
+
+            /// next block of whole lines, the previous block is released
+            bool next(const char*& begin, const char*& end);
+
+            static bool is_compressed(const std::string& filename);
+            /// whether this build links the decompressor for the suffix of filename
+            static bool can_decompress(const std::string& filename);
+            /// filename without its compression suffix ("g.mtx.gz" -> "g.mtx")
+            static std::string strip_compression(const std::string& filename);
+    };
+
+}
+#endif
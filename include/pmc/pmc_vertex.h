@@ -23,6 +23,7 @@
 #include "pmc/pmc_utils.h"
 #include "pmc_debug_utils.h"
 
+#include <algorithm>
 #include <vector>
 #include <omp.h>
 
@@ -47,6 +48,16 @@ namespace pmc {
         return (v.get_bound() < u.get_bound());
     };
 
+    // Orders P[first..] by decreasing degree, equal degrees by decreasing id.
+    // The neighbor lists are sorted by id, this is the order the searches
+    // color and branch in.
+    inline static void sort_by_degree(std::vector<Vertex>& P, int first, const std::vector<int>& degree) {
+        std::sort(P.begin() + first, P.end(), [&degree](const Vertex& v, const Vertex& u) {
+            const int dv = degree[v.get_id()], du = degree[u.get_id()];
+            return dv > du || (dv == du && v.get_id() > u.get_id());
+        });
+    }
+
     inline static void print_mc_info(const std::vector<int>& C_max, double sec) {
         DEBUG_PRINTF("*** [pmc: thread %i", omp_get_thread_num() + 1);
         DEBUG_PRINTF("]   current max clique = %i", C_max.size());
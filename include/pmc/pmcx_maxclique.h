@@ -20,6 +20,7 @@
 #ifndef PMCX_MAXCLIQUE_H_
 #define PMCX_MAXCLIQUE_H_
 
+#include "pmc_bitset_solver.h"
 #include "pmc_graph.h"
 #include "pmc_input.h"
 #include "pmc_utils.h"
@@ -34,6 +35,7 @@ namespace pmc {
         public:
             std::vector<int>* bound;
             std::vector<int>* order;
+            std::vector<int>* degree;
             int param_ub;
             int ub;
             int lb;
@@ -43,6 +45,14 @@ namespace pmc {
             bool not_reached_ub;
             bool time_expired_msg;
             bool decr_order;
+            bool use_compressed;
+            // root neighborhoods of up to bitset_limit candidates and induced density
+            // of at least bitset_density are searched by bitset_solver
+            int bitset_limit;
+            double bitset_density;
+            // roots searched by bitset_solver and over the neighbor lists
+            long long bitset_roots;
+            long long sparse_roots;
 
             std::string vertex_ordering;
             int edge_ordering;
@@ -59,6 +69,11 @@ namespace pmc {
                 not_reached_ub = true;
                 time_expired_msg = true;
                 decr_order = false;
+                use_compressed = false;
+                bitset_limit = 4096;
+                bitset_density = 0.05;
+                bitset_roots = 0;
+                sparse_roots = 0;
             }
 
             void setup_bounds(input& params) {
@@ -81,34 +96,69 @@ namespace pmc {
                 initialize();
                 vertex_ordering = params.vertex_search_order;
                 decr_order = params.decreasing_order;
+                use_compressed = params.compressed;
+                bitset_limit = params.bitset_limit;
+                bitset_density = params.bitset_density;
             }
 
             ~pmcx_maxclique() {};
 
             int search(pmc_graph& G, std::vector<int>& sol);
+            // Offset is the width of the offsets, see pmc_graph::fits_narrow_offsets()
+            template <class Offset>
+            int search_sparse(pmc_graph& G, std::vector<int>& sol);
+            int search_compressed(pmc_graph& G, std::vector<int>& sol);
+            // counts of the kernels picked by use_bitset()
+            void print_root_kernels(const char* fallback);
+            // found callback of bitset_solver, C replaces C_max if it beats mc
+            void record_clique(const std::vector<int>& C, std::vector<int>& C_max, int& mc);
+            // picks the kernel for the candidates P of a root from |P| and their density
+            template <class Adjacency>
+            inline bool use_bitset(
+                    const Adjacency& A,
+                    const std::vector<Vertex> &P,
+                    std::vector<short>& ind);
+            // bounds and branches on the neighborhood of root
+            template <class Adjacency>
+            inline void search_root(
+                    const Adjacency& A,
+                    const Vertex& root,
+                    std::vector<Vertex> &P,
+                    std::vector<short>& ind,
+                    std::vector<int>& C,
+                    std::vector<int>& C_max,
+                    std::vector< std::vector<int> >& colors,
+                    bitset_solver& solver,
+                    const bool_vector& pruned,
+                    const std::vector<int>* bound,
+                    int& mc);
+            // Adjacency is basic_csr_adjacency or compressed_csr, Ps holds the ids of P in increasing order
+            template <class Adjacency>
             inline void branch(
-                    std::vector<long long>& vs,
-                    std::vector<int>& es,
+                    const Adjacency& A,
                     std::vector<Vertex> &P,
+                    std::vector<int>& Ps,
                     std::vector<short>& ind,
                     std::vector<int>& C,
                     std::vector<int>& C_max,
                     std::vector< std::vector<int> >& colors,
                     const bool_vector& pruned,
+                    const std::vector<int>* bound,
                     int& mc);
 
             int search_dense(pmc_graph& G, std::vector<int>& sol);
             inline void branch_dense(
-                    std::vector<long long>& vs,
-                    std::vector<int>& es,
+                    const csr_array<long long>& vs,
+                    const csr_array<int>& es,
                     std::vector<Vertex> &P,
                     std::vector<short>& ind,
                     std::vector<int>& C,
                     std::vector<int>& C_max,
                     std::vector< std::vector<int> >& colors,
                     const bool_vector& pruned,
+                    const std::vector<int>* bound,
                     int& mc,
-                    const std::vector<bool_vector>& adj);
+                    const bit_matrix& adj);
 
     };
 };
@@ -88,32 +88,38 @@ namespace pmc {
             ~pmcx_maxclique_basic() {};
 
             int search(pmc_graph& G, std::vector<int>& sol);
+            // the sparse search, with the offset width picked by search() as in pmcx_maxclique
+            template <class Offset>
+            int search_sparse(pmc_graph& G, std::vector<int>& sol);
 
+            template <class Offset>
             void branch(
-                    std::vector<long long>& vs,
-                    std::vector<int>& es,
+                    const csr_array<Offset>& vs,
+                    const csr_array<int>& es,
                     std::vector<Vertex> &P,
                     std::vector<short>& ind,
                     std::vector<int>& C,
                     std::vector<int>& C_max,
                     std::vector< std::vector<int> >& colors,
                     const bool_vector& pruned,
+                    const std::vector<int>* bound,
                     int& mc);
 
 
             int search_dense(pmc_graph& G, std::vector<int>& sol);
 
             void branch_dense(
-                    std::vector<long long>& vs,
-                    std::vector<int>& es,
+                    const csr_array<long long>& vs,
+                    const csr_array<int>& es,
                     std::vector<Vertex> &P,
                     std::vector<short>& ind,
                     std::vector<int>& C,
                     std::vector<int>& C_max,
                     std::vector< std::vector<int> >& colors,
                     bool_vector& pruned,
+                    const std::vector<int>* bound,
                     int& mc,
-                    std::vector<bool_vector>& adj);
+                    bit_matrix& adj);
 
     };
 };
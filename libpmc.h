@@ -1,2 +1,11 @@
 int max_clique(long long nedges, int *ei, int *ej, int index_offset,
                 int outsize, int *clique);
+
+// symmetric CSR/CSC input: colptr has n+1 entries of ptr_width bytes and
+// rowind holds the neighbor ids in ind_width bytes (4 or 8), both starting
+// at index_offset. A CSR with 8-byte colptr, 4-byte rowind and index_offset 0
+// is searched without copying if its lists are sorted, mirrored and free of
+// self-loops and repeated entries. Returns -1 on invalid input.
+int max_clique_csr(long long n, const void *colptr, int ptr_width,
+                const void *rowind, int ind_width, int index_offset,
+                int outsize, int *clique);
@@ -8,6 +8,10 @@ extern "C" {
 // a list of edges, where index_offset is the starting index
 int max_clique(long long nedges, int *ei, int *ej, int index_offset, 
                 int outsize, int *clique);
+
+int max_clique_csr(long long n, const void *colptr, int ptr_width,
+                const void *rowind, int ind_width, int index_offset,
+                int outsize, int *clique);
                 
 };          
 
@@ -24,6 +28,54 @@ void test1() {
     }
 }      
 
+void test2() {
+    // K4 on {0,1,2,3} plus the pendant edge 3-4, as a canonical CSR
+    long long colptr[] = {0, 3, 6, 9, 13, 14};
+    int rowind[] = {1, 2, 3,  0, 2, 3,  0, 1, 3,  0, 1, 2, 4,  3};
+    int output[5] = {0, 0, 0, 0, 0};
+
+    int C = max_clique_csr(5, colptr, 8, rowind, 4, 0, 5, output);
+    if (C != 4) {
+        fprintf(stderr, "Test failed");
+        exit(-1);
+    }
+}
+
+void test3() {
+    // the same graph 1-based with 32-bit offsets and 64-bit ids, lower triangle only
+    int colptr[] = {1, 4, 6, 7, 8, 8};
+    long long rowind[] = {2, 3, 4,  3, 4,  4,  5};
+    int output[5] = {0, 0, 0, 0, 0};
+
+    int C = max_clique_csr(5, colptr, 4, rowind, 8, 1, 5, output);
+    if (C != 4) {
+        fprintf(stderr, "Test failed");
+        exit(-1);
+    }
+    for (int i = 0; i < C; i++) {
+        if (output[i] < 1 || output[i] > 4) {
+            fprintf(stderr, "Test failed");
+            exit(-1);
+        }
+    }
+}
+
+void test4() {
+    // the 1-based graph of test3 with a first offset below the base
+    int colptr[] = {0, 4, 6, 7, 8, 8};
+    long long rowind[] = {2, 3, 4,  3, 4,  4,  5};
+    int output[5] = {0, 0, 0, 0, 0};
+
+    int C = max_clique_csr(5, colptr, 4, rowind, 8, 1, 5, output);
+    if (C != -1) {
+        fprintf(stderr, "Test failed");
+        exit(-1);
+    }
+}
+
 int main(int argc, char **argv) {
     test1();
+    test2();
+    test3();
+    test4();
 };
@@ -1,28 +1,31 @@
 module PMC
 
+using SparseArrays
+
 #=
-int max_clique(long long nedges, int *ei, int *ej, int index_offset, 
+int max_clique_csr(long long n, const void *colptr, int ptr_width,
+                const void *rowind, int ind_width, int index_offset,
                 int outsize, int *clique);
 =#                
 
 const libpmc = joinpath(dirname(@Base.__FILE__),"libpmc")
 
+# A is symmetric, its column pointers and row indices are passed as they are
 function pmc(A::SparseMatrixCSC)
- maxd = Int(maximum(sum(spones(A),1)))
- ei,ej = findnz(tril(A,1))
- 
- ei = map(Int32,ei)
- ej = map(Int32,ej)
+ n = size(A,2)
+ maxd = n == 0 ? 0 : Int(maximum(diff(A.colptr)))
  
  offset = Cint(1)
  
- outsize = maxd
- output = zeros(Int32,maxd)
+ outsize = maxd + 1
+ output = zeros(Int32,outsize)
  
  clique_size = ccall( 
-    (:max_clique, libpmc), Cint,
-    (Clonglong, Ptr{Cint}, Ptr{Cint}, Cint, Cint, Ptr{Cint}),
-    length(ei), ei, ej, offset, outsize, output)
+    (:max_clique_csr, libpmc), Cint,
+    (Clonglong, Ptr{Cvoid}, Cint, Ptr{Cvoid}, Cint, Cint, Cint, Ptr{Cint}),
+    n, A.colptr, sizeof(eltype(A.colptr)), A.rowval, sizeof(eltype(A.rowval)),
+    offset, outsize, output)
+ clique_size < 0 && error("pmc: invalid sparse matrix")
     
   return map(Int64, output[1:clique_size])
 end
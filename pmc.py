@@ -1,31 +1,71 @@
+import os
+import sys
 import numpy as np
 from numpy.ctypeslib import ndpointer
 import ctypes
 
-def pmc(ei,ej,nnodes,nnedges): #ei, ej is edge list whose index starts from 0
-    degrees = np.zeros(nnodes,dtype = np.int32)
-    new_ei = []
-    new_ej = []
-    for i in range(nnedges):
-        degrees[ei[i]] += 1
-        if ej[i] <= ei[i] + 1:
-            new_ei.append(ei[i])
-            new_ej.append(ej[i])
-    maxd = max(degrees)
+# native extension (cmake -DPMC_BUILD_PYTHON=ON), the arrays are passed without
+# copying and the GIL is released during the search
+try:
+    import _pmc
+except ImportError:
+    _pmc = None
+
+def _load_library():
+    name = {"darwin": "libpmc.dylib", "win32": "pmc.dll"}.get(sys.platform, "libpmc.so")
+    local = os.path.join(os.path.dirname(os.path.abspath(__file__)), name)
+    return ctypes.cdll.LoadLibrary(local if os.path.exists(local) else name)
+
+def pmc(ei,ej,nnodes,nnedges,threads=0): #ei, ej is edge list whose index starts from 0
+    ei = np.ascontiguousarray(ei[:nnedges])
+    ej = np.ascontiguousarray(ej[:nnedges])
+    if _pmc is not None:
+        return np.array(_pmc.max_clique(ei,ej,nnodes,0,threads),dtype = np.int32)
+
+    # edges may be given in either or both directions, the library mirrors and deduplicates them
+    new_ei = ei.astype(np.int32)
+    new_ej = ej.astype(np.int32)
+    degrees = np.bincount(np.concatenate((new_ei,new_ej)),minlength = nnodes)
+    outsize = int(degrees.max()) + 1 if len(degrees) > 0 else 1
+    output = np.zeros(outsize,dtype = np.int32)
     offset = 0
-    new_ei = np.array(new_ei,dtype = np.int32)
-    new_ej = np.array(new_ej,dtype = np.int32)
-    outsize = maxd
-    output = np.zeros(maxd,dtype = np.int32)
-    lib = ctypes.cdll.LoadLibrary("libpmc.dylib")
+    lib = _load_library()
     fun = lib.max_clique
     #call C function
     fun.restype = np.int32
-    fun.argtypes = [ctypes.c_int32,ndpointer(ctypes.c_int32, flags="C_CONTIGUOUS"),
+    fun.argtypes = [ctypes.c_longlong,ndpointer(ctypes.c_int32, flags="C_CONTIGUOUS"),
                   ndpointer(ctypes.c_int32, flags="C_CONTIGUOUS"),ctypes.c_int32,
                   ctypes.c_int32,ndpointer(ctypes.c_int32, flags="C_CONTIGUOUS")]
     clique_size = fun(len(new_ei),new_ei,new_ej,offset,outsize,output)
-    max_clique = np.empty(clique_size,dtype = np.int32)
-    max_clique[:]=[output[i] for i in range(clique_size)]
+    max_clique = np.array(output[:clique_size],dtype = np.int32)
+
+    return max_clique
+
+def pmc_csr(A,threads=0): #A is a symmetric sparse matrix in CSR or CSC layout (scipy.sparse), index starts from 0
+    indptr = np.ascontiguousarray(A.indptr, dtype = np.int64)
+    indices = np.ascontiguousarray(A.indices)
+    nnodes = len(indptr) - 1
+    # 64-bit offsets and 32-bit ids are searched without copying the neighbor lists
+    if indices.dtype != np.int32 and indices.dtype != np.int64:
+        indices = indices.astype(np.int64)
+    if _pmc is not None:
+        max_clique = _pmc.max_clique_csr(indptr,indices,0,threads)
+        return np.array(max_clique,dtype = np.int32)
+
+    maxd = int(np.diff(indptr).max()) if nnodes > 0 else 0
+    outsize = maxd + 1
+    output = np.zeros(outsize,dtype = np.int32)
+    lib = _load_library()
+    fun = lib.max_clique_csr
+    #call C function
+    fun.restype = np.int32
+    fun.argtypes = [ctypes.c_longlong,ctypes.c_void_p,ctypes.c_int32,
+                  ctypes.c_void_p,ctypes.c_int32,ctypes.c_int32,
+                  ctypes.c_int32,ndpointer(ctypes.c_int32, flags="C_CONTIGUOUS")]
+    clique_size = fun(nnodes,indptr.ctypes.data,indptr.itemsize,
+                      indices.ctypes.data,indices.itemsize,0,outsize,output)
+    if clique_size < 0:
+        raise ValueError("invalid sparse matrix")
+    max_clique = np.array(output[:clique_size],dtype = np.int32)
 
     return max_clique
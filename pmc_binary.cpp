@@ -0,0 +1,209 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_builder.h"
+#include "pmc/pmc_graph.h"
+#include "pmc/pmc_mmap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+using namespace pmc;
+using namespace std;
+
+/**
+ * Binary CSR snapshot (.pmcb)
+ *
+ * A fixed size header followed by the arrays of the graph, each array
+ * starting on a 64 byte boundary so it can be used in place from a mapping:
+ *
+ *   vertices      (|V|+1) x int64
+ *   edges         2|E|    x int32
+ *   degree        |V|     x int32
+ *   kcore         kcore_len x int32   (only if PMCB_HAS_CORES)
+ *   kcore_order   kcore_len x int32   (only if PMCB_HAS_CORES)
+ *
+ * Integers are stored in the byte order of the machine that wrote the file,
+ * a reader with a different byte order rejects it through the version field.
+ */
+namespace {
+    const char pmcb_magic[4] = {'P', 'M', 'C', 'B'};
+    const uint32_t pmcb_version = 1;
+    const uint32_t PMCB_HAS_CORES = 1;
+    const uint64_t pmcb_align = 64;
+
+    struct pmcb_header {
+        char magic[4];
+        uint32_t version;
+        uint32_t flags;
+        int32_t max_core;
+        int32_t min_degree;
+        int32_t max_degree;
+        uint64_t num_vertices;
+        uint64_t num_edges;         // length of the edges array
+        uint64_t kcore_len;
+        uint64_t vertices_off;
+        uint64_t edges_off;
+        uint64_t degree_off;
+        uint64_t kcore_off;
+        uint64_t kcore_order_off;
+    };
+
+    uint64_t align_up(uint64_t x) {
+        return (x + pmcb_align - 1) / pmcb_align * pmcb_align;
+    }
+
+    bool write_section(FILE* f, uint64_t& pos, uint64_t off, const void* data, uint64_t bytes) {
+        static const char zeros[pmcb_align] = {0};
+        if (fwrite(zeros, 1, off - pos, f) != off - pos)  return false;
+        if (bytes > 0 && fwrite(data, 1, bytes, f) != bytes)  return false;
+        pos = off + bytes;
+        return true;
+    }
+}
+
+bool pmc_graph::save_binary(const string& filename) const {
+    pmcb_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, pmcb_magic, sizeof(h.magic));
+    h.version = pmcb_version;
+    h.flags = kcore.empty() ? 0 : PMCB_HAS_CORES;
+    h.max_core = kcore.empty() ? 0 : max_core;
+    h.min_degree = min_degree;
+    h.max_degree = max_degree;
+    h.num_vertices = num_vertices();
+    h.num_edges = edges.size();
+    h.kcore_len = kcore.empty() ? 0 : kcore.size();
+
+    h.vertices_off = align_up(sizeof(h));
+    h.edges_off = align_up(h.vertices_off + vertices.size() * sizeof(long long));
+    h.degree_off = align_up(h.edges_off + edges.size() * sizeof(int));
+    h.kcore_off = align_up(h.degree_off + degree.size() * sizeof(int));
+    h.kcore_order_off = align_up(h.kcore_off + h.kcore_len * sizeof(int));
+
+    FILE* f = fopen(filename.c_str(), "wb");
+    if (f == NULL) {
+        cout << "Unable to write " << filename << endl;
+        return false;
+    }
+
+    uint64_t pos = 0;
+    bool ok = write_section(f, pos, 0, &h, sizeof(h))
+        && write_section(f, pos, h.vertices_off, vertices.data(), vertices.size() * sizeof(long long))
+        && write_section(f, pos, h.edges_off, edges.data(), edges.size() * sizeof(int))
+        && write_section(f, pos, h.degree_off, degree.data(), degree.size() * sizeof(int));
+    if (ok && h.kcore_len > 0) {
+        ok = write_section(f, pos, h.kcore_off, kcore.data(), h.kcore_len * sizeof(int))
+            && write_section(f, pos, h.kcore_order_off, kcore_order.data(), h.kcore_len * sizeof(int));
+    }
+    if (fclose(f) != 0)  ok = false;
+
+    if (!ok)  cout << "Unable to write " << filename << endl;
+    return ok;
+}
+
+void pmc_graph::read_binary(const string& filename) {
+    std::shared_ptr<mapped_file> map_ptr = std::make_shared<mapped_file>();
+    mapped_file& file = *map_ptr;
+    // the search reads the arrays in random order, no readahead hint
+    if (!file.open(filename, false)) {
+        cout << filename << " not Found!" << endl;
+        return;
+    }
+
+    pmcb_header h;
+    if (file.size() < sizeof(h)) {
+        cout << "* ERROR: " << filename << " is not a pmcb file." << endl;
+        return;
+    }
+    memcpy(&h, file.data(), sizeof(h));
+    if (memcmp(h.magic, pmcb_magic, sizeof(h.magic)) != 0) {
+        cout << "* ERROR: " << filename << " is not a pmcb file." << endl;
+        return;
+    }
+    if (h.version != pmcb_version) {
+        cout << "* ERROR: unsupported pmcb version " << h.version << endl;
+        return;
+    }
+
+    const uint64_t kcore_len = (h.flags & PMCB_HAS_CORES) ? h.kcore_len : 0;
+    if (h.degree_off + h.num_vertices * sizeof(int) > file.size()
+            || h.edges_off + h.num_edges * sizeof(int) > file.size()
+            || h.vertices_off + (h.num_vertices + 1) * sizeof(long long) > file.size()
+            || h.kcore_order_off + kcore_len * sizeof(int) > file.size()) {
+        cout << "* ERROR: " << filename << " is truncated." << endl;
+        return;
+    }
+
+    if (h.num_vertices >= (uint64_t)INT32_MAX || (kcore_len > 0 && kcore_len != h.num_vertices + 1)) {
+        cout << "* ERROR: " << filename << " has an invalid header." << endl;
+        return;
+    }
+
+    // The CSR arrays are used in place, pages are faulted in by the first search.
+    // The search indexes them without bounds checks, so the offsets must be
+    // monotone and end at num_edges, and the lists sorted and in range.
+    const long long* vs = reinterpret_cast<const long long*>(file.data() + h.vertices_off);
+    const int* es = reinterpret_cast<const int*>(file.data() + h.edges_off);
+    const span<const long long> V(vs, h.num_vertices + 1);
+    const span<const int> E(es, h.num_edges);
+    if (!is_canonical_csr(V, E)) {
+        cout << "* ERROR: " << filename << " does not hold a valid graph." << endl;
+        return;
+    }
+    mapping = map_ptr;
+    vertices = V;
+    edges = E;
+    // the stored degrees are not trusted, they follow from the offsets
+    if (h.num_vertices > 0)  vertex_degrees();
+
+    if (kcore_len > 0) {
+        const int* ks = reinterpret_cast<const int*>(file.data() + h.kcore_off);
+        const int* os = reinterpret_cast<const int*>(file.data() + h.kcore_order_off);
+        kcore.assign(ks, ks + kcore_len);
+        kcore_order.assign(os, os + kcore_len);
+        max_core = h.max_core;
+        if (!valid_cores()) {
+            cout << "* WARNING: " << filename << " has invalid k-cores, they are recomputed" << endl;
+            kcore.clear();
+            kcore_order.clear();
+            max_core = 0;
+        }
+    }
+}
+
+// kcore[v] = core + 1 is at most deg(v) + 1, max_core is the largest core and
+// kcore_order lists every vertex once
+bool pmc_graph::valid_cores() const {
+    const int n = num_vertices();
+    int largest = 0;
+    vector<char> seen(n, 0);
+    for (int v = 0; v < n; v++) {
+        if (kcore[v] < 1 || kcore[v] > degree[v] + 1)  return false;
+        largest = max(largest, kcore[v] - 1);
+        const int u = kcore_order[v];
+        if (u < 0 || u >= n || seen[u])  return false;
+        seen[u] = 1;
+    }
+    return largest == max_core;
+}
@@ -0,0 +1,95 @@
+#include "pmc/pmc.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// .pmcb snapshots: a saved graph loads back unchanged, and files whose CSR
+// was corrupted after saving are rejected instead of searched.
+
+namespace {
+
+// where the header (pmcb_header in pmc_binary.cpp) keeps the array offsets:
+// magic, version, flags, three int32, three uint64 counts, then the offsets
+const long header_vertices_off = 4 + 4 + 4 + 3 * 4 + 3 * 8;
+const long header_edges_off = header_vertices_off + 8;
+
+const string path = "pmc_binary_test.pmcb";
+
+void fail(const char* what) {
+    fprintf(stderr, "Test failed: %s\n", what);
+    exit(-1);
+}
+
+// K5 plus the path 4-5-6
+pmc_graph sample() {
+    vector<long long> vs = {0, 4, 8, 12, 16, 21, 23, 24};
+    vector<int> es = {1, 2, 3, 4,  0, 2, 3, 4,  0, 1, 3, 4,  0, 1, 2, 4,  0, 1, 2, 3, 5,  4, 6,  5};
+    return pmc_graph(std::move(vs), std::move(es));
+}
+
+uint64_t read_u64(FILE* f, long off) {
+    uint64_t x = 0;
+    fseek(f, off, SEEK_SET);
+    if (fread(&x, sizeof(x), 1, f) != 1)  fail("short header");
+    return x;
+}
+
+// overwrites one entry of the offsets (array 0) or of the edges (array 1)
+void patch(int array, long index, long long value) {
+    FILE* f = fopen(path.c_str(), "r+b");
+    if (f == NULL)  fail("cannot open the snapshot");
+    if (array == 0) {
+        fseek(f, read_u64(f, header_vertices_off) + index * sizeof(long long), SEEK_SET);
+        fwrite(&value, sizeof(value), 1, f);
+    }
+    else {
+        const int x = static_cast<int>(value);
+        fseek(f, read_u64(f, header_edges_off) + index * sizeof(int), SEEK_SET);
+        fwrite(&x, sizeof(x), 1, f);
+    }
+    fclose(f);
+}
+
+void save() {
+    pmc_graph G = sample();
+    G.compute_cores();
+    if (!G.save_binary(path))  fail("save_binary");
+}
+
+}
+
+void test_round_trip() {
+    save();
+    pmc_graph G = sample(), H(path);
+    G.compute_cores();
+    if (!H.is_loaded())  fail("snapshot not loaded");
+    if (H.get_vertices_array() != G.get_vertices_array() || H.get_edges_array() != G.get_edges_array())
+        fail("CSR differs");
+    if (*H.get_kcores() != *G.get_kcores() || H.get_max_core() != G.get_max_core())
+        fail("k-cores differ");
+    if (*H.get_degree() != *G.get_degree())  fail("degrees differ");
+}
+
+void test_corrupt() {
+    // an id past n, a list out of order, offsets going back, a wrong last offset
+    const long long edits[][3] = { {1, 5, 100}, {1, 1, 3}, {0, 2, 3}, {0, 7, 20}, {1, 0, -1} };
+    for (auto& e : edits) {
+        save();
+        patch(e[0], e[1], e[2]);
+        pmc_graph H(path);
+        if (H.is_loaded())  fail("corrupt snapshot was loaded");
+    }
+}
+
+int main(int argc, char **argv) {
+    test_round_trip();
+    test_corrupt();
+    remove(path.c_str());
+}
@@ -0,0 +1,110 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_bitset_solver.h"
+
+using namespace pmc;
+using namespace std;
+
+bool bitset_solver::reorder(int mc) {
+    // bin sort of Batagelj and Zaversnik over the popcount degrees
+    deg.resize(p);  core.resize(p);
+    pos.resize(p);  vert.resize(p);
+    int md = 0;
+    for (int i = 0; i < p; i++) {
+        const uint64_t* r = row(i);
+        int d = 0;
+        for (int w = 0; w < words; w++)  d += __builtin_popcountll(r[w]);
+        deg[i] = d;
+        if (d > md)  md = d;
+    }
+
+    bin.assign(md + 1, 0);
+    for (int i = 0; i < p; i++)  bin[deg[i]]++;
+    int start = 0;
+    for (int d = 0; d <= md; d++) {
+        int num = bin[d];
+        bin[d] = start;
+        start += num;
+    }
+    for (int i = 0; i < p; i++) {
+        pos[i] = bin[deg[i]];
+        vert[pos[i]] = i;
+        bin[deg[i]]++;
+    }
+    for (int d = md; d > 0; d--)  bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    for (int i = 0; i < p; i++) {
+        const int v = vert[i];
+        core[v] = deg[v];
+        const uint64_t* r = row(v);
+        for (int w = 0; w < words; w++) {
+            for (uint64_t b = r[w]; b; b &= b - 1) {
+                const int u = (w << 6) + __builtin_ctzll(b);
+                if (deg[u] > deg[v]) {
+                    const int du = deg[u], pu = pos[u];
+                    const int pw = bin[du], x = vert[pw];
+                    if (u != x) {
+                        pos[u] = pw;  vert[pu] = x;
+                        pos[x] = pu;  vert[pw] = u;
+                    }
+                    bin[du]++;
+                    deg[u]--;
+                }
+            }
+        }
+    }
+
+    // a clique of size mc+1 in P needs core >= mc, vert[] is by increasing core
+    int kept = 0;
+    for (int i = p - 1; i >= 0 && core[vert[i]] >= mc; i--)  kept++;
+    if (kept <= mc)  return false;
+
+    const int nwords = (kept + 63) / 64;
+    rename.assign(p, -1);
+    for (int i = 0; i < kept; i++)  rename[vert[p - 1 - i]] = i;
+
+    tmp.assign((size_t)kept * nwords, 0);
+    for (int i = 0; i < kept; i++) {
+        const uint64_t* r = row(vert[p - 1 - i]);
+        uint64_t* t = tmp.data() + (size_t)i * nwords;
+        for (int w = 0; w < words; w++) {
+            for (uint64_t b = r[w]; b; b &= b - 1) {
+                const int j = rename[(w << 6) + __builtin_ctzll(b)];
+                if (j >= 0)  set_bit(t, j);
+            }
+        }
+    }
+    // ids are renamed in place, vert[] still refers to the old local ids
+    for (int i = 0; i < kept; i++)  pos[i] = ids[vert[p - 1 - i]];
+    for (int i = 0; i < kept; i++)  ids[i] = pos[i];
+    rows.swap(tmp);
+    p = kept;
+    words = nwords;
+    return true;
+}
+
+void bitset_solver::refresh_alive(const vector<int>& bound, const bool_vector& pruned, int mc) {
+    alive.assign(words, 0);
+    for (int i = 0; i < p; i++)
+        if (bound[ids[i]] > mc && !pruned[ids[i]])
+            set_bit(alive.data(), i);
+    alive_mc = mc;
+}
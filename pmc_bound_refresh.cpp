@@ -0,0 +1,124 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_bound_refresh.h"
+#include "pmc/pmc_debug_utils.h"
+#include "pmc/pmc_graph.h"
+
+
+using namespace pmc;
+using namespace std;
+
+bound_refresh::bound_refresh(pmc_graph& graph, const bool_vector& pruned) :
+        G(graph), pending(false), done(false), refreshes(0) {
+    front = make_shared<const vector<int>>(G.kcore);
+    current = front;
+    // taken before the searchers start writing pruned
+    for (int v = 0; v < G.num_vertices(); v++)
+        if (pruned[v])  newly_pruned.push_back(v);
+    worker = thread(&bound_refresh::run, this);
+}
+
+bound_refresh::~bound_refresh() {
+    if (worker.joinable()) {
+        {
+            lock_guard<mutex> guard(lock);
+            done = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+}
+
+void bound_refresh::request() {
+    {
+        lock_guard<mutex> guard(lock);
+        pending = true;
+    }
+    wake.notify_one();
+}
+
+void bound_refresh::stop() {
+    if (!worker.joinable())  return;
+    {
+        lock_guard<mutex> guard(lock);
+        done = true;
+    }
+    wake.notify_one();
+    worker.join();
+
+    G.kcore = *front;
+    for (int v : unpublished)  G.kcore[v] = bound(v);
+    if (cores != nullptr)  G.max_core = cores->max_core();
+    DEBUG_PRINTF("[pmc: bound refresh]  %i refreshes, K: %i\n", refreshes, G.max_core);
+}
+
+void bound_refresh::run() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [this] { return pending || done; });
+        if (done)  return;
+        pending = false;
+        guard.unlock();
+        refresh();
+        guard.lock();
+    }
+}
+
+/**
+ * Removes the vertices pruned since the last refresh and publishes the new bounds
+ *   + a new array costs O(n), so it is published only once n/64 bounds changed,
+ *     until then the searchers keep the older bounds, which are still valid
+ *   + the array is always a fresh copy, a searcher may still read the old one
+ */
+void bound_refresh::refresh() {
+    // the cores are set up here rather than in the constructor, off the search threads
+    if (cores == nullptr) {
+        cores.reset(new core_maintenance(G.get_vertices(), G.get_edges(), *front));
+        is_unpublished.assign(cores->num_vertices(), 0);
+    }
+
+    vector<int> newly;
+    {
+        lock_guard<mutex> guard(pruned_lock);
+        newly.swap(newly_pruned);
+    }
+    cores->remove_vertices(newly);
+
+    vector<int> changed;
+    cores->take_changed(changed);
+    for (int v : changed) {
+        if (!is_unpublished[v]) {
+            is_unpublished[v] = 1;
+            unpublished.push_back(v);
+        }
+    }
+    if (unpublished.empty() || (int)unpublished.size() < cores->num_vertices() / 64)  return;
+
+    shared_ptr<vector<int>> next = make_shared<vector<int>>(*front);
+    for (int v : unpublished) {
+        (*next)[v] = bound(v);
+        is_unpublished[v] = 0;
+    }
+    unpublished.clear();
+
+    front = next;
+    atomic_store(&current, front);
+    refreshes++;
+}
@@ -0,0 +1,228 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_builder.h"
+
+#include <algorithm>
+#include <omp.h>
+
+using namespace pmc;
+using namespace std;
+
+void pmc::prefix_sum(vector<long long>& a) {
+    const long long n = a.size();
+    int nthreads = omp_get_max_threads();
+    vector<long long> block_sum(nthreads + 1, 0);
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        const int t = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+        const long long lo = n * t / nt, hi = n * (t + 1) / nt;
+        for (long long i = lo + 1; i < hi; i++)  a[i] += a[i - 1];
+        block_sum[t + 1] = hi > lo ? a[hi - 1] : 0;
+
+        #pragma omp barrier
+        #pragma omp single
+        for (int i = 1; i <= nt; i++)  block_sum[i] += block_sum[i - 1];
+
+        for (long long i = lo; i < hi; i++)  a[i] += block_sum[t];
+    }
+}
+
+namespace {
+    // drops repeated neighbors from the sorted lists of a CSR, returns the number removed
+    long long compact_csr(vector<long long>& vertices, vector<int>& edges) {
+        const long long n = vertices.size() - 1;
+        vector<long long> V(n + 1, 0);
+        long long removed = 0;
+
+        #pragma omp parallel for schedule(dynamic, 1024) reduction(+:removed)
+        for (long long v = 0; v < n; v++) {
+            const long long d = std::unique(edges.begin() + vertices[v], edges.begin() + vertices[v + 1])
+                - (edges.begin() + vertices[v]);
+            V[v + 1] = d;
+            removed += vertices[v + 1] - vertices[v] - d;
+        }
+        if (removed == 0)  return 0;
+        prefix_sum(V);
+
+        vector<int> E(V[n]);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (long long v = 0; v < n; v++)
+            std::copy(edges.begin() + vertices[v], edges.begin() + vertices[v] + (V[v + 1] - V[v]),
+                    E.begin() + V[v]);
+
+        vertices.swap(V);
+        edges.swap(E);
+        return removed;
+    }
+}
+
+long long pmc::build_csr(int n, const vector<const vector<int>*>& pairs, int offset,
+        vector<long long>& vertices, vector<int>& edges) {
+    const long long num_lists = pairs.size();
+    vertices.assign(n + 1, 0);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long c = 0; c < num_lists; c++) {
+        const vector<int>& e = *pairs[c];
+        for (size_t i = 0; i < e.size(); i += 2) {
+            if (e[i] == e[i + 1])  continue;
+            #pragma omp atomic
+            vertices[e[i] - offset + 1]++;
+            #pragma omp atomic
+            vertices[e[i + 1] - offset + 1]++;
+        }
+    }
+    prefix_sum(vertices);
+
+    edges.resize(vertices[n]);
+    vector<long long> fill(vertices.begin(), vertices.end() - 1);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long c = 0; c < num_lists; c++) {
+        const vector<int>& e = *pairs[c];
+        for (size_t i = 0; i < e.size(); i += 2) {
+            const int v = e[i] - offset, u = e[i + 1] - offset;
+            if (v == u)  continue;
+            long long pv, pu;
+            #pragma omp atomic capture
+            pv = fill[v]++;
+            #pragma omp atomic capture
+            pu = fill[u]++;
+            edges[pv] = u;
+            edges[pu] = v;
+        }
+    }
+
+    // scatter order depends on the schedule, sort to keep the CSR deterministic
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (int v = 0; v < n; v++)
+        std::sort(edges.begin() + vertices[v], edges.begin() + vertices[v + 1]);
+
+    return compact_csr(vertices, edges) / 2;
+}
+
+void pmc::canonicalize_csr(vector<long long>& vertices, vector<int>& edges) {
+    const long long n = vertices.size() - 1;
+    long long self_loops = 0, unsorted = 0, missing = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:self_loops,unsorted)
+    for (long long v = 0; v < n; v++) {
+        for (long long j = vertices[v]; j < vertices[v + 1]; j++) {
+            if (edges[j] == v)  self_loops++;
+            if (j > vertices[v] && edges[j - 1] > edges[j])  unsorted++;
+        }
+    }
+    if (unsorted > 0) {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (long long v = 0; v < n; v++)
+            std::sort(edges.begin() + vertices[v], edges.begin() + vertices[v + 1]);
+    }
+
+    // entries whose mirror is missing
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:missing)
+    for (long long v = 0; v < n; v++) {
+        for (long long j = vertices[v]; j < vertices[v + 1]; j++) {
+            const int u = edges[j];
+            if (u != v && !std::binary_search(edges.begin() + vertices[u], edges.begin() + vertices[u + 1], (int)v))
+                missing++;
+        }
+    }
+
+    if (self_loops == 0 && missing == 0) {
+        compact_csr(vertices, edges);
+        return;
+    }
+
+    // rebuild from the lists taken as (v, u) pairs, one pair list per range of vertices
+    const int num_lists = omp_get_max_threads() * 4;
+    vector< vector<int> > pairs(num_lists);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int c = 0; c < num_lists; c++) {
+        const long long lo = n * c / num_lists, hi = n * (c + 1) / num_lists;
+        pairs[c].reserve(2 * (vertices[hi] - vertices[lo]));
+        for (long long v = lo; v < hi; v++) {
+            for (long long j = vertices[v]; j < vertices[v + 1]; j++) {
+                pairs[c].push_back(v);
+                pairs[c].push_back(edges[j]);
+            }
+        }
+    }
+
+    vector<const vector<int>*> lists(num_lists);
+    for (int c = 0; c < num_lists; c++)  lists[c] = &pairs[c];
+    build_csr(n, lists, 0, vertices, edges);
+}
+
+bool pmc::is_canonical_csr(span<const long long> vertices, span<const int> edges) {
+    if (vertices.empty() || vertices[0] != 0 || vertices[vertices.size() - 1] != (long long)edges.size())
+        return false;
+    const long long n = vertices.size() - 1, m = edges.size();
+    auto valid_list = [&](long long v) {
+        return 0 <= vertices[v] && vertices[v] <= vertices[v + 1] && vertices[v + 1] <= m;
+    };
+    long long bad = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:bad)
+    for (long long v = 0; v < n; v++) {
+        if (!valid_list(v)) {
+            bad++;
+            continue;
+        }
+        for (long long j = vertices[v]; j < vertices[v + 1]; j++) {
+            const int u = edges[j];
+            // in range, no self-loop, strictly increasing and mirrored
+            if (u < 0 || u >= n || u == v || (j > vertices[v] && edges[j - 1] >= u) || !valid_list(u)
+                    || !std::binary_search(edges.begin() + vertices[u], edges.begin() + vertices[u + 1], (int)v))
+                bad++;
+        }
+    }
+    return bad == 0;
+}
+
+edge_buffer& graph_builder::get_buffer() {
+    lock_guard<mutex> lk(lock);
+    buffers.emplace_back();
+    return buffers.back();
+}
+
+int graph_builder::num_vertices() const {
+    int num = n;
+    for (const edge_buffer& b : buffers)
+        num = std::max(num, b.max_id + 1);
+    return num;
+}
+
+long long graph_builder::num_edges() const {
+    long long m = 0;
+    for (const edge_buffer& b : buffers)  m += b.size();
+    return m;
+}
+
+void graph_builder::finalize(vector<long long>& vertices, vector<int>& edges) {
+    vector<const vector<int>*> pairs;
+    for (const edge_buffer& b : buffers)
+        if (!b.pairs.empty())  pairs.push_back(&b.pairs);
+
+    duplicates = build_csr(num_vertices(), pairs, 0, vertices, edges);
+    buffers.clear();
+}
@@ -35,39 +35,39 @@ int pmc_graph::initial_pruning(pmc_graph& G, bool_vector& pruned, int lb) {
     }
 
     double sec = get_time();
-    DEBUG_PRINTF("[pmc: initial k-core pruning]  before pruning: |V| = %i, |E| = %i\n", G.num_vertices(), G.num_edges());
+    DEBUG_PRINTF("[pmc: initial k-core pruning]  before pruning: |V| = %i, |E| = %lld\n", G.num_vertices(), G.num_edges());
     G.reduce_graph(pruned);
-    DEBUG_PRINTF("[pmc: initial k-core pruning]  after pruning:  |V| = %i, |E| = %i\n", G.num_vertices() - lb_idx, G.num_edges());
+    DEBUG_PRINTF("[pmc: initial k-core pruning]  after pruning:  |V| = %i, |E| = %lld\n", G.num_vertices() - lb_idx, G.num_edges());
     DEBUG_PRINTF("[pmc]  initial pruning took %i sec\n", get_time()-sec);
 
+    // the neighbor lists stay sorted by id for the intersections of the search,
+    // which orders the neighbors of each root by degree (sort_by_degree)
     G.update_degrees();
-    G.degree_bucket_sort(true); // largest to smallest degree
 
     return lb_idx;
 }
 
 
-int pmc_graph::initial_pruning(pmc_graph& G, bool_vector& pruned, int lb, std::vector<bool_vector>& adj) {
+int pmc_graph::initial_pruning(pmc_graph& G, bool_vector& pruned, int lb, bit_matrix& adj) {
     int lb_idx = 0;
     for (int i = G.num_vertices()-1; i >= 0; i--) {
         if (kcore[kcore_order[i]] == lb)  lb_idx = i;
         if (kcore[kcore_order[i]] <= lb) {
             pruned[kcore_order[i]] = 1;
             for (long long j = vertices[kcore_order[i]]; j < vertices[kcore_order[i] + 1]; j++) {
-                adj[kcore_order[i]][edges[j]] = false;
-                adj[edges[j]][kcore_order[i]] = false;
+                adj.reset(kcore_order[i], edges[j]);
+                adj.reset(edges[j], kcore_order[i]);
             }
         }
     }
 
     double sec = get_time();
-    DEBUG_PRINTF("[pmc: initial k-core pruning]  before pruning: |V| = %i, |E| = %i\n", G.num_vertices(), G.num_edges());
+    DEBUG_PRINTF("[pmc: initial k-core pruning]  before pruning: |V| = %i, |E| = %lld\n", G.num_vertices(), G.num_edges());
     G.reduce_graph(pruned);
-    DEBUG_PRINTF("[pmc: initial k-core pruning]  after pruning:  |V| = %i, |E| = %i\n", G.num_vertices() - lb_idx, G.num_edges());
+    DEBUG_PRINTF("[pmc: initial k-core pruning]  after pruning:  |V| = %i, |E| = %lld\n", G.num_vertices() - lb_idx, G.num_edges());
     DEBUG_PRINTF("[pmc]  initial pruning took %i sec\n", get_time()-sec);
 
     G.update_degrees();
-    G.degree_bucket_sort(true);
 
     return lb_idx;
 }
@@ -93,16 +93,12 @@ void pmc_graph::order_vertices(vector<Vertex> &V, pmc_graph &G,
             // neighbor degrees
             else if (vertex_ordering == "dual_deg") {
                 val = 0;
-                for (long long j = vertices[u]; j < vertices[u + 1]; j++) {
-                    val = val + G.vertex_degree(edges[j]);
-                }
+                for_each_neighbor(u, [&](int w) { val = val + G.vertex_degree(w); });
             }
             // neighbor degrees
             else if (vertex_ordering == "dual_kcore") {
                 val = 0;
-                for (long long j = vertices[u]; j < vertices[u + 1]; j++) {
-                    val = val + kcore[edges[j]];
-                }
+                for_each_neighbor(u, [&](int w) { val = val + kcore[w]; });
             }
             else  val = vertices[u + 1] - vertices[u];
             V.push_back(Vertex(u,val));
@@ -122,24 +118,26 @@ void pmc_graph::order_vertices(vector<Vertex> &V, pmc_graph &G,
  * The algorithm below is for parallel maximum clique finders and has the following features:
  *   + Thread-safe, since local copy of vertices/edges are passed in..
  *   + Pruned is a shared variable, but it is safe, since only reads/writes can occur, no deletion
+ *   + The k-cores are not touched here, the search threads share them through bound_refresh
  */
+template <class Offset>
 void pmc_graph::reduce_graph(
-        vector<long long>& vs,
-        vector<int>& es,
+        csr_array<Offset>& vs,
+        csr_array<int>& es,
         const bool_vector& pruned,
-        pmc_graph& G) {
+        pmc_graph& /*G*/) {
 
     int num_vs = vs.size();
 
-    vector<long long> V(num_vs,0);
+    vector<Offset> V(num_vs,0);
     vector<int> E;
     E.reserve(es.size());
 
-    int start = 0;
+    Offset start = 0;
     for (int i = 0; i < num_vs - 1; i++) {
         start = E.size();
         if (!pruned[i]) { //skip these V_local...
-            for (long long j = vs[i]; j < vs[i + 1]; j++ ) {
+            for (Offset j = vs[i]; j < vs[i + 1]; j++ ) {
                 if (!pruned[es[j]])
                     E.push_back(es[j]);
             }
@@ -147,17 +145,21 @@ void pmc_graph::reduce_graph(
         V[i] = start;
         V[i + 1] = E.size();
     }
-    vs = V;
-    es = E;
-
-    // compute k-cores and share bounds: ensure operation completed by single process
-    #pragma omp single nowait
-    {
-        cout << ">>> [pmc: thread " << omp_get_thread_num() + 1 << "]" <<endl;
-        G.induced_cores_ordering(vs,es);
-    }
-    V.clear();
-    E.clear();
+    // the reduced copy is owned by the calling thread from here on
+    vs = std::move(V);
+    es = std::move(E);
+}
+
+template void pmc_graph::reduce_graph(csr_array<long long>&, csr_array<int>&, const bool_vector&, pmc_graph&);
+template void pmc_graph::reduce_graph(csr_array<uint32_t>&, csr_array<int>&, const bool_vector&, pmc_graph&);
+
+
+void pmc_graph::offsets(csr_array<uint32_t>& vs) const {
+    vector<uint32_t> V(vertices.size());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)vertices.size(); i++)
+        V[i] = static_cast<uint32_t>(vertices[i]);
+    vs = std::move(V);
 }
 
 
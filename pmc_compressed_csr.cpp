@@ -0,0 +1,110 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_compressed_csr.h"
+#include "pmc/pmc_builder.h"
+#include "pmc/pmc_graph.h"
+
+#include <algorithm>
+#include <iostream>
+#include <omp.h>
+
+using namespace pmc;
+using namespace std;
+
+namespace {
+    inline int varint_size(uint32_t x) {
+        int n = 1;
+        while (x >= 0x80) {
+            x >>= 7;
+            n++;
+        }
+        return n;
+    }
+
+    inline void write_varint(uint8_t*& p, uint32_t x) {
+        while (x >= 0x80) {
+            *p++ = static_cast<uint8_t>(x | 0x80);
+            x >>= 7;
+        }
+        *p++ = static_cast<uint8_t>(x);
+    }
+
+    inline uint32_t zigzag(long long x) {
+        return static_cast<uint32_t>((x << 1) ^ (x >> 63));
+    }
+
+    // neighbors of v in increasing order, sorted into tmp only if the CSR list is not
+    const int* sorted_list(const csr_array<long long>& vs, const csr_array<int>& es, int v, vector<int>& tmp) {
+        const int* first = es.data() + vs[v];
+        const int* last = es.data() + vs[v + 1];
+        if (std::is_sorted(first, last))  return first;
+        tmp.assign(first, last);
+        std::sort(tmp.begin(), tmp.end());
+        return tmp.data();
+    }
+}
+
+compressed_csr::compressed_csr(const csr_array<long long>& vs, const csr_array<int>& es) {
+    const int n = vs.empty() ? 0 : vs.size() - 1;
+    offsets.assign(n + 1, 0);
+
+    // encoded size of each list, then the offsets by a prefix sum
+    #pragma omp parallel
+    {
+        vector<int> tmp;
+        #pragma omp for schedule(dynamic, 1024)
+        for (int v = 0; v < n; v++) {
+            const int d = vs[v + 1] - vs[v];
+            const int* list = sorted_list(vs, es, v, tmp);
+            long long bytes = varint_size(d);
+            if (d > 0)  bytes += varint_size(zigzag((long long)list[0] - v));
+            for (int i = 1; i < d; i++)  bytes += varint_size(list[i] - list[i - 1]);
+            offsets[v + 1] = bytes;
+        }
+    }
+    prefix_sum(offsets);
+    data.resize(offsets[n]);
+
+    #pragma omp parallel
+    {
+        vector<int> tmp;
+        #pragma omp for schedule(dynamic, 1024)
+        for (int v = 0; v < n; v++) {
+            const int d = vs[v + 1] - vs[v];
+            const int* list = sorted_list(vs, es, v, tmp);
+            uint8_t* p = data.data() + offsets[v];
+            write_varint(p, d);
+            if (d > 0)  write_varint(p, zigzag((long long)list[0] - v));
+            for (int i = 1; i < d; i++)  write_varint(p, list[i] - list[i - 1]);
+        }
+    }
+}
+
+void pmc_graph::compress_edges(bool release_edges) {
+    if (compressed == nullptr) {
+        compressed = std::make_shared<const compressed_csr>(vertices, edges);
+        cout << "compressed neighbor lists: " << compressed->list_bytes() / 1048576.0 << " MB, plain: "
+            << edges.size() * sizeof(int) / 1048576.0 << " MB" << endl;
+    }
+    if (release_edges) {
+        edges = csr_array<int>();
+        dynamic_cores.reset();
+    }
+}
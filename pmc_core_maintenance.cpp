@@ -0,0 +1,248 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_core_maintenance.h"
+
+#include <algorithm>
+
+using namespace pmc;
+using namespace std;
+
+core_maintenance::core_maintenance(
+        const csr_array<long long>& vertices,
+        const csr_array<int>& edges,
+        const vector<int>& kcore) :
+        vs(vertices.view()), es(edges.view()), kmax(0), cur_stamp(0) {
+
+    const int n = vs.size() - 1;
+    core.resize(n);
+    mcd.assign(n, 0);
+    removed.assign(n, 0);
+    stamp.assign(n, 0);
+    cd.assign(n, 0);
+    queued.assign(n, 0);
+    is_changed.assign(n, 0);
+
+    #pragma omp parallel for schedule(static) reduction(max:kmax)
+    for (int v = 0; v < n; v++) {
+        core[v] = max(kcore[v] - 1, 0);
+        kmax = max(kmax, core[v]);
+    }
+
+    #pragma omp parallel for schedule(dynamic,64)
+    for (int v = 0; v < n; v++) {
+        int m = 0;
+        for (long long j = vs[v]; j < vs[v + 1]; j++)
+            if (core[es[j]] >= core[v])  m++;
+        mcd[v] = m;
+    }
+
+    count.assign(kmax + 2, 0);
+    for (int v = 0; v < n; v++)  count[core[v]]++;
+
+    // the given cores are only an upper bound, settle them
+    for (int v = 0; v < n; v++)
+        if (mcd[v] < core[v])  push(v);
+    lower_cores();
+}
+
+bool core_maintenance::in_csr(int u, int v) const {
+    return binary_search(es.data() + vs[u], es.data() + vs[u + 1], v);
+}
+
+bool core_maintenance::has_edge(int u, int v) const {
+    if (u == v || removed[u] || removed[v])  return false;
+    if (in_csr(u, v))  return deleted.count(edge_key(u, v)) == 0;
+    auto it = added.find(u);
+    return it != added.end() && find(it->second.begin(), it->second.end(), v) != it->second.end();
+}
+
+int core_maintenance::max_core() {
+    while (kmax > 0 && count[kmax] == 0)  kmax--;
+    return kmax;
+}
+
+int core_maintenance::next_stamp() {
+    if (++cur_stamp == 0) {
+        fill(stamp.begin(), stamp.end(), 0);
+        cur_stamp = 1;
+    }
+    return cur_stamp;
+}
+
+void core_maintenance::set_core(int v, int k) {
+    count[core[v]]--;
+    if (k + 1 >= (int)count.size())  count.resize(k + 2, 0);
+    count[k]++;
+    if (k > kmax)  kmax = k;
+    core[v] = k;
+    if (!is_changed[v]) {
+        is_changed[v] = 1;
+        changed_vertices.push_back(v);
+    }
+}
+
+void core_maintenance::push(int v) {
+    if (!queued[v]) {
+        queued[v] = 1;
+        queue.push_back(v);
+    }
+}
+
+/**
+ * Lowers the cores of the queued vertices, one step at a time, until each
+ * vertex has at least core(v) neighbors of core >= core(v). Starting from
+ * upper bounds this stops at the exact core numbers.
+ */
+void core_maintenance::lower_cores() {
+    while (!queue.empty()) {
+        const int x = queue.back();
+        queue.pop_back();
+        queued[x] = 0;
+        if (removed[x] || mcd[x] >= core[x])  continue;
+
+        const int K = core[x];
+        set_core(x, K - 1);
+        int m = 0;
+        for_each_neighbor(x, [&](int y) {
+            if (core[y] >= K - 1)  m++;
+            // x no longer counts for its neighbors of core K
+            if (core[y] == K && --mcd[y] < K)  push(y);
+        });
+        mcd[x] = m;
+        if (m < core[x])  push(x);
+    }
+}
+
+bool core_maintenance::remove_vertex(int v) {
+    if (removed[v])  return false;
+    remove_vertices(vector<int>(1, v));
+    return true;
+}
+
+void core_maintenance::remove_vertices(const vector<int>& V) {
+    for (int v : V) {
+        if (removed[v])  continue;
+        removed[v] = 1;
+        for_each_neighbor(v, [&](int u) {
+            if (core[v] >= core[u] && --mcd[u] < core[u])  push(u);
+        });
+        set_core(v, 0);
+        mcd[v] = 0;
+    }
+    lower_cores();
+}
+
+bool core_maintenance::remove_edge(int u, int v) {
+    if (!has_edge(u, v))  return false;
+
+    if (in_csr(u, v))  deleted.insert(edge_key(u, v));
+    else {
+        vector<int>& a = added[u];
+        a.erase(find(a.begin(), a.end(), v));
+        vector<int>& b = added[v];
+        b.erase(find(b.begin(), b.end(), u));
+    }
+
+    if (core[v] >= core[u] && --mcd[u] < core[u])  push(u);
+    if (core[u] >= core[v] && --mcd[v] < core[v])  push(v);
+    lower_cores();
+    return true;
+}
+
+/**
+ * Inserting (u,v) raises the core of some vertices of core K = min(core(u), core(v))
+ * by one, all of them connected to an endpoint of core K through each other.
+ *   + candidates: the vertices of core K reached from those endpoints through
+ *     vertices with mcd > K (the others cannot have K+1 neighbors in the new (K+1)-core)
+ *   + candidates with at most K neighbors among the (K+1)-core and the remaining
+ *     candidates are evicted, repeatedly; the rest move to core K+1
+ */
+bool core_maintenance::insert_edge(int u, int v) {
+    if (u == v || removed[u] || removed[v] || has_edge(u, v))  return false;
+
+    const long long key = edge_key(u, v);
+    if (in_csr(u, v))  deleted.erase(key);
+    else {
+        added[u].push_back(v);
+        added[v].push_back(u);
+    }
+    if (core[v] >= core[u])  mcd[u]++;
+    if (core[u] >= core[v])  mcd[v]++;
+
+    const int K = min(core[u], core[v]);
+    const int s = next_stamp();
+
+    // stamp[w] == s marks a candidate, cd[w] < 0 an evicted one
+    vector<int> candidates;
+    for (int r : {u, v}) {
+        if (core[r] == K && mcd[r] > K && stamp[r] != s) {
+            stamp[r] = s;
+            candidates.push_back(r);
+        }
+    }
+    for (size_t i = 0; i < candidates.size(); i++) {
+        for_each_neighbor(candidates[i], [&](int w) {
+            if (core[w] == K && mcd[w] > K && stamp[w] != s) {
+                stamp[w] = s;
+                candidates.push_back(w);
+            }
+        });
+    }
+
+    vector<int> evict;
+    for (int w : candidates) {
+        int c = 0;
+        for_each_neighbor(w, [&](int x) {
+            if (core[x] > K || stamp[x] == s)  c++;
+        });
+        cd[w] = c;
+        if (c <= K)  evict.push_back(w);
+    }
+    while (!evict.empty()) {
+        const int w = evict.back();
+        evict.pop_back();
+        if (cd[w] < 0)  continue;
+        cd[w] = -1;
+        for_each_neighbor(w, [&](int x) {
+            if (stamp[x] == s && cd[x] >= 0 && --cd[x] == K)  evict.push_back(x);
+        });
+    }
+
+    for (int w : candidates)
+        if (cd[w] >= 0)  set_core(w, K + 1);
+
+    for (int w : candidates) {
+        if (cd[w] < 0)  continue;
+        int m = 0;
+        for_each_neighbor(w, [&](int x) {
+            if (core[x] >= K + 1)  m++;
+            // w now counts for its neighbors of core K+1 that did not move
+            if (core[x] == K + 1 && (stamp[x] != s || cd[x] < 0))  mcd[x]++;
+        });
+        mcd[w] = m;
+    }
+    return true;
+}
+
+void core_maintenance::take_changed(vector<int>& V) {
+    for (int v : changed_vertices)  is_changed[v] = 0;
+    V.swap(changed_vertices);
+    changed_vertices.clear();
+}
@@ -0,0 +1,136 @@
+#include "pmc/pmc.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// core_maintenance under random edge insertions, edge deletions and vertex
+// removals, checked after every step against compute_cores() of the graph
+// rebuilt from scratch.
+
+namespace {
+
+void fail(const char* what, int step) {
+    fprintf(stderr, "Test failed: %s at step %i\n", what, step);
+    exit(-1);
+}
+
+pmc_graph make_graph(int n, const set< pair<int,int> >& E) {
+    vector< vector<int> > N(n);
+    for (const auto& e : E) {
+        N[e.first].push_back(e.second);
+        N[e.second].push_back(e.first);
+    }
+    vector<long long> vs(1, 0);
+    vector<int> es;
+    for (const vector<int>& l : N) {
+        es.insert(es.end(), l.begin(), l.end());
+        vs.push_back(es.size());
+    }
+    return pmc_graph(std::move(vs), std::move(es));
+}
+
+void check(core_maintenance& cores, int n, const set< pair<int,int> >& E,
+        const vector<char>& removed, int step) {
+    // removed vertices have no edges left in E
+    pmc_graph H = make_graph(n, E);
+    H.compute_cores();
+    const vector<int>& K = *H.get_kcores();
+    for (int v = 0; v < n; v++) {
+        if ((bool)cores.is_removed(v) != (bool)removed[v])  fail("removed flag", step);
+        if (!removed[v] && cores.core_number(v) != K[v] - 1)  fail("core number", step);
+    }
+    if (cores.max_core() != H.get_max_core())  fail("max core", step);
+}
+
+void drop_vertex(set< pair<int,int> >& E, int v) {
+    for (auto it = E.begin(); it != E.end(); ) {
+        if (it->first == v || it->second == v)  it = E.erase(it);
+        else ++it;
+    }
+}
+
+// n vertices, edges with probability 1/sparsity, plus cliques planted on
+// random vertex sets
+void random_updates(unsigned seed, int n, int sparsity, int cliques, int clique_size) {
+    mt19937 rng(seed);
+    set< pair<int,int> > E;
+    for (int v = 0; v < n; v++)
+        for (int u = v + 1; u < n; u++)
+            if (rng() % sparsity == 0)  E.insert({v, u});
+    for (int c = 0; c < cliques; c++) {
+        vector<int> S;
+        for (int i = 0; i < clique_size; i++)  S.push_back(rng() % n);
+        for (int v : S)
+            for (int u : S)
+                if (v < u)  E.insert({v, u});
+    }
+
+    // the CSR stays as built, the updates are kept on the side
+    pmc_graph G = make_graph(n, E);
+    G.compute_cores();
+    core_maintenance cores(G.get_vertices(), G.get_edges(), *G.get_kcores());
+    vector<char> removed(n, 0);
+    check(cores, n, E, removed, 0);
+
+    for (int step = 1; step <= 300; step++) {
+        const int op = rng() % 10;
+        const int v = rng() % n, u = rng() % n;
+        if (op < 4) {
+            if (u == v || removed[v] || removed[u])  continue;
+            const pair<int,int> e(min(v, u), max(v, u));
+            const bool changed = cores.insert_edge(v, u);
+            if (changed != !E.count(e))  fail("insert_edge result", step);
+            E.insert(e);
+        }
+        else if (op < 8) {
+            if (E.empty())  continue;
+            auto it = E.begin();
+            advance(it, rng() % E.size());
+            if (!cores.remove_edge(it->first, it->second))  fail("remove_edge result", step);
+            E.erase(it);
+        }
+        else if (op < 9) {
+            if (cores.remove_vertex(v) != !removed[v])  fail("remove_vertex result", step);
+            removed[v] = 1;
+            drop_vertex(E, v);
+        }
+        else {
+            // several vertices at once, with a single propagation
+            vector<int> V;
+            for (int i = 0; i < 3; i++) {
+                const int w = rng() % n;
+                if (!removed[w] && find(V.begin(), V.end(), w) == V.end())  V.push_back(w);
+            }
+            cores.remove_vertices(V);
+            for (int w : V) {
+                removed[w] = 1;
+                drop_vertex(E, w);
+            }
+        }
+        check(cores, n, E, removed, step);
+    }
+}
+
+}
+
+void test_sparse() {
+    for (unsigned seed = 1; seed <= 5; seed++)  random_updates(seed, 40, 8, 0, 0);
+}
+
+void test_clique_heavy() {
+    for (unsigned seed = 11; seed <= 15; seed++)  random_updates(seed, 40, 20, 4, 8);
+}
+
+int main(int argc, char **argv) {
+    test_sparse();
+    test_clique_heavy();
+}
@@ -22,9 +22,10 @@
 using namespace pmc;
 using namespace std;
 
+template <class Offset>
 void pmc_graph::induced_cores_ordering(
-        vector<long long>& V,
-        vector<int>& E) {
+        const csr_array<Offset>& V,
+        const csr_array<int>& E) {
 
     long long n, d, i, j, start, num, md;
     long long v, u, w, du, pu, pw, md_end;
@@ -84,13 +85,23 @@ void pmc_graph::induced_cores_ordering(
 
     kcore = core_tmp;
     kcore_order = order_tmp;
+    dynamic_cores.reset();
     bin.clear();
 }
 
+template void pmc_graph::induced_cores_ordering(const csr_array<long long>&, const csr_array<int>&);
+template void pmc_graph::induced_cores_ordering(const csr_array<uint32_t>&, const csr_array<int>&);
+
 
 
 
 void pmc_graph::compute_cores() {
+    dynamic_cores.reset();
+    if (parallel_cores) {
+        compute_cores_parallel();
+        return;
+    }
+
     long long j;
     int n, d, i, start, num, md;
     int v, u, w, du, pu, pw, md_end;
@@ -161,3 +172,85 @@ void pmc_graph::compute_cores() {
     bin.clear();
     pos.clear();
 }
+
+
+/**
+ * Parallel k-cores by level-synchronous peeling (PKC)
+ *   + level k: the threads scan their part of the vertices for remaining degree k,
+ *     then remove them and their neighbors that drop to k, decrementing atomically
+ *   + kcore and max_core match compute_cores(); kcore_order lists the vertices
+ *     by increasing core number, in the order they were removed within a level
+ */
+void pmc_graph::compute_cores_parallel() {
+    dynamic_cores.reset();
+    const int n = num_vertices();
+    vector<int> deg(n);
+    kcore.assign(n + 1, 0);
+    kcore_order.assign(n + 1, 0);
+    max_core = 0;
+    if (n <= 0)  return;
+
+    #pragma omp parallel for schedule(static)
+    for (int v = 0; v < n; v++)  deg[v] = vertices[v + 1] - vertices[v];
+
+    const int nthreads = omp_get_max_threads();
+    vector<long long> offset(nthreads + 1, 0);
+    long long removed = 0;
+    int level = 0;
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        const int t = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+        vector<int> buf;
+
+        while (removed < n) {
+            buf.clear();
+            #pragma omp for schedule(static)
+            for (int v = 0; v < n; v++)
+                if (deg[v] == level)  buf.push_back(v);
+
+            for (size_t i = 0; i < buf.size(); i++) {
+                const int v = buf[i];
+                for (long long j = vertices[v]; j < vertices[v + 1]; j++) {
+                    const int u = edges[j];
+                    // other threads decrement deg[u] meanwhile
+                    int d;
+                    #pragma omp atomic read
+                    d = deg[u];
+                    if (d > level) {
+                        int du;
+                        #pragma omp atomic capture
+                        du = deg[u]--;
+                        if (du == level + 1)  buf.push_back(u);
+                        else if (du <= level) {
+                            // another thread got there first, u stays at this level
+                            #pragma omp atomic
+                            deg[u]++;
+                        }
+                    }
+                }
+            }
+
+            // the removed vertices go to kcore_order in thread order
+            offset[t + 1] = buf.size();
+            #pragma omp barrier
+            #pragma omp single
+            {
+                for (int i = 1; i <= nt; i++)  offset[i] += offset[i - 1];
+            }
+            const long long pos = removed + offset[t];
+            for (size_t i = 0; i < buf.size(); i++) {
+                kcore_order[pos + i] = buf[i];
+                kcore[buf[i]] = level + 1;   // K + 1
+            }
+            #pragma omp barrier
+            #pragma omp single
+            {
+                if (offset[nt] > 0)  max_core = level;
+                removed += offset[nt];
+                level++;
+            }
+        }
+    }
+}
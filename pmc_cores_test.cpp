@@ -0,0 +1,107 @@
+#include "pmc/pmc.h"
+
+#include <omp.h>
+#include <random>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// The parallel peeling (compute_cores_parallel) against the bin sort of
+// compute_cores(), on several threads.
+
+namespace {
+
+void fail(const char* what, unsigned seed) {
+    fprintf(stderr, "Test failed: %s, graph %u\n", what, seed);
+    exit(-1);
+}
+
+pmc_graph make_graph(int n, const set< pair<int,int> >& E) {
+    vector< vector<int> > N(n);
+    for (const auto& e : E) {
+        N[e.first].push_back(e.second);
+        N[e.second].push_back(e.first);
+    }
+    vector<long long> vs(1, 0);
+    vector<int> es;
+    for (const vector<int>& l : N) {
+        es.insert(es.end(), l.begin(), l.end());
+        vs.push_back(es.size());
+    }
+    return pmc_graph(std::move(vs), std::move(es));
+}
+
+// n vertices, edges with probability 1/sparsity, plus cliques planted on
+// random vertex sets
+set< pair<int,int> > random_edges(unsigned seed, int n, int sparsity, int cliques, int clique_size) {
+    mt19937 rng(seed);
+    set< pair<int,int> > E;
+    for (int v = 0; v < n; v++)
+        for (int u = v + 1; u < n; u++)
+            if (rng() % sparsity == 0)  E.insert({v, u});
+    for (int c = 0; c < cliques; c++) {
+        vector<int> S;
+        for (int i = 0; i < clique_size; i++)  S.push_back(rng() % n);
+        for (int v : S)
+            for (int u : S)
+                if (v < u)  E.insert({v, u});
+    }
+    return E;
+}
+
+void compare(unsigned seed, int n, const set< pair<int,int> >& E) {
+    pmc_graph G = make_graph(n, E), H = make_graph(n, E);
+    G.compute_cores();
+    H.compute_cores_parallel();
+
+    const vector<int>& K = *G.get_kcores();
+    const vector<int>& P = *H.get_kcores();
+    for (int v = 0; v < n; v++)
+        if (K[v] != P[v])  fail("kcore", seed);
+    if (G.get_max_core() != H.get_max_core())  fail("max_core", seed);
+
+    // the removal order is a permutation by increasing core number
+    const vector<int>& order = *H.get_kcore_ordering();
+    vector<char> seen(n, 0);
+    for (int i = 0; i < n; i++) {
+        const int v = order[i];
+        if (v < 0 || v >= n || seen[v])  fail("kcore_order is not a permutation", seed);
+        seen[v] = 1;
+        if (i > 0 && P[order[i - 1]] > P[v])  fail("kcore_order is not by core number", seed);
+    }
+}
+
+}
+
+void test_random() {
+    for (unsigned seed = 1; seed <= 8; seed++)
+        compare(seed, 500, random_edges(seed, 500, 5 + 20 * (seed % 4), 0, 0));
+}
+
+void test_clique_heavy() {
+    for (unsigned seed = 21; seed <= 26; seed++)
+        compare(seed, 400, random_edges(seed, 400, 60, 10, 10 + seed % 20));
+}
+
+void test_special() {
+    // isolated vertices only, a star, and K_30
+    compare(31, 50, set< pair<int,int> >());
+    set< pair<int,int> > star, K;
+    for (int v = 1; v < 50; v++)  star.insert({0, v});
+    compare(32, 50, star);
+    for (int v = 0; v < 30; v++)
+        for (int u = v + 1; u < 30; u++)  K.insert({v, u});
+    compare(33, 30, K);
+}
+
+int main(int argc, char **argv) {
+    omp_set_num_threads(4);
+    test_random();
+    test_clique_heavy();
+    test_special();
+}
@@ -20,6 +20,9 @@
 #include "pmc/pmc.h"
 #include "pmc/pmc_input.h"
 
+#include <algorithm>
+#include <thread>
+
 using namespace std;
 using namespace pmc;
 
@@ -32,8 +35,20 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
-    //! read graph
-    pmc_graph G(in.graph_stats,in.graph);
+    //! a snapshot of the graph pruned for one lower bound would be read back as the whole graph
+    if (!in.binary_out.empty() && in.lb > 2) {
+        cout << "* ERROR: -b saves the whole graph, it cannot be combined with -l or -k, which prune it while loading" << endl;
+        return 1;
+    }
+
+    //! read graph, a given lower bound drops low degree vertices while loading
+    const double start = get_time();
+    pmc_graph G(in.graph_stats,in.graph,in.lb);
+    if (!G.is_loaded()) {
+        cout << "* ERROR: could not read " << in.graph << endl;
+        return 1;
+    }
+    const double read_time = get_time() - start;
     if (in.graph_stats) { G.bound_stats(in.algorithm); }
 
     //! ensure wait time is greater than the time to recompute the graph data structures
@@ -41,9 +56,30 @@ int main(int argc, char *argv[]) {
     else if (G.num_edges() > 250000000 && in.remove_time < 10) in.remove_time = 10;
     cout << "explicit reduce is set to " << in.remove_time << " seconds" <<endl;
 
-    //! upper-bound of max clique
+    //! upper-bound of max clique (k-cores may come with a binary snapshot)
     double seconds = get_time();
-    G.compute_cores();
+    G.parallel_cores = (in.cores == "pkc");
+    if (!G.has_cores())  G.compute_cores();
+    const double cores_time = get_time() - seconds;
+
+    //! the snapshot is written while the heuristic runs, it only reads the CSR
+    //! and is joined before the graph is changed or searched. The dense adjacency
+    //! is not built here: it covers the vertices left by compact(), which needs
+    //! the heuristic's lower bound and rewrites the CSR the heuristic reads.
+    thread snapshot;
+    bool saved = false;
+    double save_time = 0;
+    if (!in.binary_out.empty()) {
+        snapshot = thread([&] {
+            double sec = get_time();
+            saved = G.save_binary(in.binary_out);
+            save_time = get_time() - sec;
+        });
+        // relabeling rewrites the arrays being saved
+        if (!in.relabel.empty())  snapshot.join();
+    }
+    //! relabel vertices for locality, cliques are mapped back before printing
+    if (!in.relabel.empty())  G.relabel(in.relabel);
     if (in.ub == 0) {
         in.ub = G.get_max_core() + 1;
         cout << "K: " << in.ub <<endl;
@@ -51,26 +87,64 @@ int main(int argc, char *argv[]) {
     }
 
     //! lower-bound of max clique
-    vector<int> C;
+    vector<int> C, H;
+    double heu_time = 0;
     if (in.lb == 0 && in.heu_strat != "0") { // skip if given as input
+        double sec = get_time();
         pmc_heu maxclique(G,in);
         in.lb = maxclique.search(G, C);
+        heu_time = get_time() - sec;
         cout << "Heuristic found clique of size " << in.lb;
         cout << " in " << get_time() - seconds << " seconds" <<endl;
         cout << "[pmc: heuristic]  ";
-        print_max_clique(C);
+        H = G.original_ids(C);
+        print_max_clique(H);
+    }
+    const double incumbent_time = get_time() - start;
+
+    if (snapshot.joinable())  snapshot.join();
+    if (saved)  cout << "saved binary snapshot to " << in.binary_out << endl;
+
+    //! k-truss pruning, a clique of size k only has edges in k-2 triangles
+    double truss_time = 0;
+    if (in.truss && in.algorithm >= 0 && in.lb < in.ub) {
+        double sec = get_time();
+        int max_truss = G.truss_pruning(in.lb);
+        in.ub = min(in.ub, min(max_truss, G.get_max_core() + 1));
+        truss_time = get_time() - sec;
+        cout << "k-truss time: " << truss_time << ", ub: " << in.ub << endl;
+    }
+
+    //! the vertices the initial pruning would remove are dropped and the rest renamed,
+    //! so the dense search is picked by the number left and its matrix only covers them
+    bool dense = false;
+    double compact_time = 0, adj_time = 0;
+    if (in.algorithm >= 0 && in.lb < in.ub) {
+        const int n = G.num_vertices();
+        double sec = get_time();
+        G.compact(in.lb);
+        compact_time = get_time() - sec;
+        if (G.num_vertices() < n)
+            cout << "[pmc: compact]  |V| = " << G.num_vertices() << " of " << n << ", |E| = " << G.num_edges() << endl;
+        dense = (in.algorithm == 0 || in.algorithm == 1) && G.num_vertices() < in.adj_limit;
+        if (dense) {
+            sec = get_time();
+            G.create_adj();
+            adj_time = get_time() - sec;
+        }
     }
 
     //! check solution found by heuristic
+    double search_time = 0;
     if (in.lb == in.ub && !in.MCE) {
         cout << "Heuristic found optimal solution." << endl;
     }
     else if (in.algorithm >= 0) {
+        double sec = get_time();
         switch(in.algorithm) {
             case 0: {
                 //! k-core pruning, neigh-core pruning/ordering, dynamic coloring bounds/sort
-                if (G.num_vertices() < in.adj_limit) {
-                    G.create_adj();
+                if (dense) {
                     pmcx_maxclique finder(G,in);
                     finder.search_dense(G,C);
                     break;
@@ -83,8 +157,7 @@ int main(int argc, char *argv[]) {
             }
             case 1: {
                 //! k-core pruning, dynamic coloring bounds/sort
-                if (G.num_vertices() < in.adj_limit) {
-                    G.create_adj();
+                if (dense) {
                     pmcx_maxclique_basic finder(G,in);
                     finder.search_dense(G,C);
                     break;
@@ -105,15 +178,27 @@ int main(int argc, char *argv[]) {
                 cout << "algorithm " << in.algorithm << " not found." <<endl;
                 break;
         }
+        search_time = get_time() - sec;
         seconds = (get_time() - seconds);
         cout << "Time taken: " << seconds << " SEC" << endl;
         cout << "Size (omega): " << C.size() << endl;
+        // C is only written by a search that beats the lower bound, otherwise it
+        // still holds the heuristic clique, in the ids from before compact()
+        C = C.size() > in.lb ? G.original_ids(C) : H;
         print_max_clique(C);
 
         if (C.size() < in.param_ub)
             cout << "Clique of size " << in.param_ub << " does not exist." <<endl;
     }
     C.clear();
+
+    cout << "[pmc: timings]  read " << read_time << " s, k-cores " << cores_time
+        << " s, heuristic " << heu_time << " s, first incumbent at " << incumbent_time << " s";
+    if (!in.binary_out.empty())  cout << ", snapshot " << save_time << " s";
+    if (in.algorithm >= 0 && in.lb < in.ub)  cout << ", compact " << compact_time << " s";
+    if (dense)  cout << ", adjacency " << adj_time << " s";
+    if (in.truss)  cout << ", k-truss " << truss_time << " s";
+    cout << ", search " << search_time << " s" << endl;
   cout << "Done." << endl;
   return 0;
 }
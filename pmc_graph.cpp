@@ -20,13 +20,16 @@
 #include "pmc/pmc_debug_utils.h"
 #include "pmc/pmc_utils.h"
 #include "pmc/pmc_graph.h"
+#include "pmc/pmc_builder.h"
 #include "pmc/pmc_headers.h"
+#include "pmc/pmc_mmap.h"
+#include "pmc/pmc_parse.h"
+#include "pmc/pmc_stream.h"
 
+#include <algorithm>
 #include <cstring>
-#include <fstream>
 #include <iostream>
 #include <limits>
-#include <sstream>
 
 using namespace pmc;
 using namespace std;
@@ -38,6 +41,8 @@ void pmc_graph::initialize() {
     avg_degree = 0;
     max_core = 0;
     is_gstats = false;
+    parallel_cores = false;
+    loaded = true;
 }
 
 pmc_graph::~pmc_graph() {
@@ -46,27 +51,33 @@ pmc_graph::~pmc_graph() {
 pmc_graph::pmc_graph(const string& filename) {
     initialize();
     fn = filename;
-    read_graph(filename);
+    loaded = read_graph(filename);
 }
 
-pmc_graph::pmc_graph(bool graph_stats, const string& filename) {
+pmc_graph::pmc_graph(bool graph_stats, const string& filename, int lb) {
     initialize();
     fn = filename;
     is_gstats = graph_stats;
-    read_graph(filename);
+    if (lb > 2)  loaded = read_graph(filename, lb);
+    else loaded = read_graph(filename);
 }
 
 pmc_graph::pmc_graph(const string& filename, bool make_adj) {
     initialize();
     fn = filename;
-    read_graph(filename);
-    if (make_adj) create_adj();
+    loaded = read_graph(filename);
+    if (make_adj && loaded) create_adj();
 }
 
-void pmc_graph::read_graph(const string& filename) {
+bool pmc_graph::read_graph(const string& filename) {
     fn = filename;
     double sec = get_time();
-    string ext = get_file_extension(filename);
+    // a compressed file is read with the format of its inner extension (g.mtx.gz)
+    string ext = get_file_extension(line_reader::strip_compression(filename));
+    if (line_reader::is_compressed(filename) && (ext == "pmcb" || !line_reader::can_decompress(filename))) {
+        cout << "Unsupported compression format." <<endl;
+        return false;
+    }
 
     if (ext == "edges" || ext == "eg2" || ext == "txt")
         read_edges(filename);
@@ -74,11 +85,84 @@ void pmc_graph::read_graph(const string& filename) {
         read_mtx(filename);
     else if (ext == "gr")
         read_metis(filename);
+    else if (ext == "pmcb")
+        read_binary(filename);
     else {
         cout << "Unsupported graph format." <<endl;
-        return;
+        return false;
+    }
+    // the readers leave the graph empty when the file could not be read
+    if (vertices.empty())  return false;
+    basic_stats(sec);
+    return true;
+}
+
+bool pmc_graph::read_graph(const string& filename, int lb) {
+    string ext = get_file_extension(line_reader::strip_compression(filename));
+    const bool is_edges = ext == "edges" || ext == "eg2" || ext == "txt";
+    if (lb < 3 || is_gstats || !(is_edges || ext == "mtx")
+            || (line_reader::is_compressed(filename) && !line_reader::can_decompress(filename))) {
+        return read_graph(filename);
+    }
+    fn = filename;
+    double sec = get_time();
+
+    // pass one: entries per vertex, an upper bound on its degree
+    edge_filter filter;
+    filter.count_only = true;
+    if (is_edges)  read_edges(filename, &filter);
+    else read_mtx(filename, &filter);
+
+    const long long n = filter.degree.size();
+    long long kept = 0;
+    filter.keep.resize(n);
+    #pragma omp parallel for schedule(static) reduction(+:kept)
+    for (long long v = 0; v < n; v++) {
+        filter.keep[v] = filter.degree[v] >= lb - 1;
+        kept += filter.keep[v];
     }
+    filter.degree = vector<long long>();
+    filter.count_only = false;
+    cout << "[pmc: streaming load]  lb = " << lb << ", kept " << kept << " of " << n << " vertices" << endl;
+
+    // pass two: only edges between kept vertices, then peel to the (lb-1)-core
+    if (is_edges)  read_edges(filename, &filter);
+    else read_mtx(filename, &filter);
+    if (vertices.empty())  return false;
+    peel(lb - 1);
     basic_stats(sec);
+    return true;
+}
+
+void pmc_graph::peel(int d) {
+    const int n = num_vertices();
+    vector<int> deg(n);
+    bool_vector pruned(n);
+    vector<int> stack;
+    for (int v = 0; v < n; v++) {
+        deg[v] = vertices[v + 1] - vertices[v];
+        if (deg[v] < d) {
+            pruned[v] = true;
+            if (deg[v] > 0)  stack.push_back(v);
+        }
+    }
+    long long removed = stack.size();
+    while (!stack.empty()) {
+        const int v = stack.back();
+        stack.pop_back();
+        for (long long j = vertices[v]; j < vertices[v + 1]; j++) {
+            const int u = edges[j];
+            if (!pruned[u] && --deg[u] < d) {
+                pruned[u] = true;
+                stack.push_back(u);
+                removed++;
+            }
+        }
+    }
+    if (removed == 0)  return;
+    reduce_graph(pruned);
+    vertex_degrees();
+    DEBUG_PRINTF("[pmc: peel]  removed %lld vertices of degree < %i\n", removed, d);
 }
 
 void pmc_graph::basic_stats(double sec) {
@@ -91,105 +175,363 @@ void pmc_graph::basic_stats(double sec) {
 }
 
 
-void pmc_graph::read_edges(const string& filename) {
-    istringstream in_stream;
-    string line = "";
-    map< int, vector<int> > vert_list;
-    int v = 0, u = 0, self_edges = 0;
+namespace {
+    // edges parsed from one chunk of a text graph file, in file order
+    struct edge_chunk {
+        vector<int> pairs;              // v_0, u_0, v_1, u_1, ...
+        long long entries = 0;          // number of data lines consumed
+        long long self_loops = 0;
+        long long bad_ids = 0;
+        long long min_id = std::numeric_limits<long long>::max();
+        long long max_id = -1;          // largest id of a non self-loop edge
+    };
+
+    // edge list lines "v u", ids are kept as read and shifted once the base is known
+    void parse_edges_chunk(const char* p, const char* end, edge_chunk& chunk) {
+        long long v = 0, u = 0;
+
+        while (p < end) {
+            const char* eol = line_end(p, end);
+            const char* q = p;
+            p = eol < end ? eol + 1 : end;
+            if (q == eol || *q == '%' || *q == '#')  continue;
+            if (!parse_int(q, eol, v) || !parse_int(q, eol, u))  continue;
+            chunk.entries++;
+
+            if (v < 0 || u < 0 || v > std::numeric_limits<int>::max() || u > std::numeric_limits<int>::max()) {
+                chunk.bad_ids++;
+                continue;
+            }
+            chunk.min_id = std::min(chunk.min_id, std::min(v, u));
+            if (v == u) {
+                chunk.self_loops++;
+                continue;
+            }
+            chunk.max_id = std::max(chunk.max_id, std::max(v, u));
+            chunk.pairs.push_back(v);
+            chunk.pairs.push_back(u);
+        }
+    }
+
+    void parse_mtx_chunk(const char* p, const char* end, int n, bool b_getValue,
+            long long max_entries, edge_chunk& chunk) {
+        const float connStrength = std::numeric_limits<float>::lowest();
+        long long ridx = 0, cidx = 0;
+        double value = 0;
 
-    ifstream in_check (filename.c_str());
-    if (!in_check) { cout << filename << "File not found!" <<endl; return; }
+        while (p < end && chunk.entries < max_entries) {
+            const char* eol = line_end(p, end);
+            const char* q = skip_blanks(p, eol);
+            p = eol < end ? eol + 1 : end;
+            if (q == eol || *q == '%')  continue;
+            if (!parse_int(q, eol, ridx) || !parse_int(q, eol, cidx))  continue;
+            chunk.entries++;
 
-    bool fix_start_idx = true;
-    while (!in_check.eof()) {
-        getline(in_check,line);
-        if (line[0] == '%' || line[0] == '#') continue;
-        if (line != "") {
-            in_stream.clear();
-            in_stream.str(line);
-            in_stream >> v >> u;
-            if (v == 0 || u == 0) {
-                fix_start_idx = false;
-                break;
+            ridx--;
+            cidx--;
+            if (ridx < 0 || ridx >= n || cidx < 0 || cidx >= n) {
+                chunk.bad_ids++;
+                continue;
             }
+            if (ridx == cidx) {
+                chunk.self_loops++;
+                continue;
+            }
+            if (b_getValue && !(parse_double(q, eol, value) && value > connStrength))
+                continue;
+            chunk.pairs.push_back(ridx);
+            chunk.pairs.push_back(cidx);
         }
     }
-    ifstream in (filename.c_str());
-    if (!in) { cout << filename << "File not found!" <<endl; return; }
 
-    while (!in.eof()) {
-        getline(in,line);
-        if (line[0] == '%' || line[0] == '#') continue;
-        if (line != "") {
-            in_stream.clear();
-            in_stream.str(line);
-            in_stream >> v >> u;
+    // the pair lists of the parsed chunks, in file order
+    vector<const vector<int>*> chunk_pairs(const vector<edge_chunk>& chunks) {
+        vector<const vector<int>*> pairs(chunks.size());
+        for (size_t i = 0; i < chunks.size(); i++)  pairs[i] = &chunks[i].pairs;
+        return pairs;
+    }
 
-            if (fix_start_idx) {
-                v--;
-                u--;
+    // counts or drops the pairs of the chunks from first on, see pmc_graph::edge_filter
+    void filter_chunks(vector<edge_chunk>& chunks, size_t first, bool count_only,
+            vector<long long>& degree, const vector<char>& keep) {
+        if (count_only) {
+            long long max_id = (long long)degree.size() - 1;
+            for (size_t i = first; i < chunks.size(); i++)
+                for (int x : chunks[i].pairs)  max_id = std::max(max_id, (long long)x);
+            degree.resize(max_id + 1, 0);
+        }
+
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t i = first; i < chunks.size(); i++) {
+            vector<int>& e = chunks[i].pairs;
+            if (count_only) {
+                for (int x : e) {
+                    #pragma omp atomic
+                    degree[x]++;
+                }
+                vector<int>().swap(e);
+                continue;
             }
-            if (v == u)  self_edges++;
-            else {
-                vert_list[v].push_back(u);
-                vert_list[u].push_back(v);
+            size_t k = 0;
+            for (size_t j = 0; j < e.size(); j += 2) {
+                if (e[j] < (long long)keep.size() && keep[e[j]] && e[j+1] < (long long)keep.size() && keep[e[j+1]]) {
+                    e[k++] = e[j];
+                    e[k++] = e[j+1];
+                }
             }
+            e.resize(k);
+            e.shrink_to_fit();
         }
     }
-    vertices.push_back(edges.size());
-    for (int i=0; i < vert_list.size(); i++) {
-        edges.insert(edges.end(),vert_list[i].begin(),vert_list[i].end());
-        vertices.push_back(edges.size());
+}
+
+void pmc_graph::read_edges(const string& filename, edge_filter* filter) {
+    line_reader in(filename);
+    if (!in.is_open()) { cout << filename << "File not found!" <<endl; return; }
+    double sec = get_time();
+
+    vector<edge_chunk> chunks;
+    long long min_id = std::numeric_limits<long long>::max(), max_id = -1;
+    long long self_edges = 0, bad_ids = 0;
+    const char *begin, *end;
+
+    // compressed inputs arrive in blocks, the next one is decompressed while this one is parsed
+    while (in.next(begin, end)) {
+        vector<const char*> bounds = split_lines(begin, end,
+                num_parse_chunks(end - begin, omp_get_max_threads()));
+        size_t num_chunks = bounds.size() - 1, first = chunks.size();
+        chunks.resize(first + num_chunks);
+
+        #pragma omp parallel for schedule(dynamic) \
+            reduction(min:min_id) reduction(max:max_id) reduction(+:self_edges,bad_ids)
+        for (size_t i = 0; i < num_chunks; i++) {
+            edge_chunk& chunk = chunks[first + i];
+            parse_edges_chunk(bounds[i], bounds[i+1], chunk);
+            min_id = std::min(min_id, chunk.min_id);
+            max_id = std::max(max_id, chunk.max_id);
+            self_edges += chunk.self_loops;
+            bad_ids += chunk.bad_ids;
+        }
+        if (filter != nullptr)  filter_chunks(chunks, first, filter->count_only, filter->degree, filter->keep);
     }
-    vert_list.clear();
+    if (in.error())  cout << "* WARNING: " << filename << " is corrupt, reading stopped early" << endl;
+    if (filter != nullptr && filter->count_only)  return;
+    if (bad_ids > 0)  cout << "invalid vertex ids: " << bad_ids <<endl;
+
+    // ids start at 1 unless a vertex 0 appears anywhere in the file
+    int offset = (min_id == 0) ? 0 : 1;
+    int n = max_id < 0 ? 0 : static_cast<int>(max_id + 1 - offset);
+
+    vector<long long> V;
+    vector<int> E;
+    long long duplicates = build_csr(n, chunk_pairs(chunks), offset, V, E);
+    chunks.clear();
+    vertices = std::move(V);
+    edges = std::move(E);
     vertex_degrees();
     cout << "self-loops: " << self_edges <<endl;
+    if (duplicates > 0)  cout << "duplicate edges: " << duplicates <<endl;
+
+    double parse_sec = get_time() - sec;
+    cout << "Parse throughput: " << (in.bytes() / 1048576.0) / parse_sec << " MB/s" << endl;
+}
+
+void pmc_graph::read_metis(const string& filename) {
+    line_reader in(filename);
+    if (!in.is_open()) { cout << filename << " not Found!" <<endl; return; }
+    double sec = get_time();
+
+    long long n = -1, m = 0, fmt = 0, ncon = 0, skip = 0;
+    bool has_ewgt = false;
+    vector<long long> V(1, 0);
+    vector<int> E;
+    long long bad_ids = 0;
+    const char *p, *end;
+
+    while ((n < 0 || (long long)V.size() - 1 < n) && in.next(p, end)) {
+        if (n < 0) {
+            // header: n m [fmt [ncon]]
+            while (p < end && *p == '%')  p = next_line(p, end);
+            if (p == end)  continue;
+            const char* eol = line_end(p, end);
+            if (!parse_int(p, eol, n) || !parse_int(p, eol, m) || n < 0 || n > std::numeric_limits<int>::max()) {
+                cout << "* ERROR: METIS header is missing" << endl;
+                return;
+            }
+            if (parse_int(p, eol, fmt))  parse_int(p, eol, ncon);
+            const bool has_vsize = (fmt / 100) % 10 == 1;
+            const bool has_vwgt = (fmt / 10) % 10 == 1;
+            has_ewgt = fmt % 10 == 1;
+            if (has_vwgt && ncon == 0)  ncon = 1;
+            skip = (has_vsize ? 1 : 0) + (has_vwgt ? ncon : 0);
+            V.reserve(n + 1);
+            p = next_line(p, end);
+        }
+
+        // line i+1 of the body holds the neighbors of vertex i, comment lines excluded
+        vector<const char*> bounds = split_lines(p, end, num_parse_chunks(end - p, omp_get_max_threads()));
+        size_t num_chunks = bounds.size() - 1;
+        vector< vector<const char*> > chunk_lines(num_chunks);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t c = 0; c < num_chunks; c++) {
+            for (const char* q = bounds[c]; q < bounds[c+1]; q = next_line(q, bounds[c+1]))
+                if (*q != '%')  chunk_lines[c].push_back(q);
+        }
+
+        const long long v0 = V.size() - 1;
+        vector<const char*> lines;
+        for (size_t c = 0; c < num_chunks && v0 + (long long)lines.size() < n; c++)
+            lines.insert(lines.end(), chunk_lines[c].begin(), chunk_lines[c].end());
+        chunk_lines.clear();
+        if (v0 + (long long)lines.size() > n)  lines.resize(n - v0);
+        const long long k = lines.size();
+
+        // visit the neighbors of vertex v0+i, skipping self-loops and invalid ids
+        auto for_each_neigh = [&](long long i, long long& bad, auto&& f) {
+            const char* q = lines[i];
+            const char* e = line_end(q, end);
+            long long x = 0, w = 0;
+            for (long long j = 0; j < skip; j++)  parse_int(q, e, x);
+            while (parse_int(q, e, x)) {
+                if (has_ewgt)  parse_int(q, e, w);
+                if (x < 1 || x > n)  bad++;
+                else if (x - 1 != v0 + i)  f(static_cast<int>(x - 1));
+            }
+        };
+
+        vector<long long> deg(k + 1, 0);
+        deg[0] = V.back();
+
+        #pragma omp parallel for schedule(dynamic, 1024) reduction(+:bad_ids)
+        for (long long i = 0; i < k; i++) {
+            long long d = 0;
+            for_each_neigh(i, bad_ids, [&d](int) { d++; });
+            deg[i + 1] = d;
+        }
+        prefix_sum(deg);
+        V.insert(V.end(), deg.begin() + 1, deg.end());
+        E.resize(V.back());
+        long long unused = 0;
+
+        #pragma omp parallel for schedule(dynamic, 1024) reduction(+:unused)
+        for (long long i = 0; i < k; i++) {
+            long long pos = deg[i];
+            for_each_neigh(i, unused, [&](int u) { E[pos++] = u; });
+            std::sort(E.begin() + deg[i], E.begin() + deg[i + 1]);
+        }
+    }
+
+    if (n < 0) {
+        cout << "* ERROR: METIS header is missing" << endl;
+        return;
+    }
+    if (in.error())  cout << "* WARNING: " << filename << " is corrupt, reading stopped early" << endl;
+    if ((long long)V.size() - 1 < n) {
+        cout << "* WARNING: METIS file lists " << V.size() - 1 << " of " << n << " vertices" << endl;
+        V.resize(n + 1, V.back());
+    }
+    if (bad_ids > 0)  cout << "invalid vertex ids: " << bad_ids <<endl;
+    if (V[n] != 2 * m)  cout << "* WARNING: METIS header lists " << m << " edges, found " << V[n] / 2 << endl;
+
+    // edges listed for one endpoint only are mirrored, repeated neighbors dropped
+    canonicalize_csr(V, E);
+    vertices = std::move(V);
+    edges = std::move(E);
+    vertex_degrees();
+
+    double parse_sec = get_time() - sec;
+    cout << "Parse throughput: " << (in.bytes() / 1048576.0) / parse_sec << " MB/s" << endl;
+}
+
+pmc_graph::pmc_graph(vector<long long> vs, vector<int> es) {
+    initialize();
+    canonicalize_csr(vs, es);
+    vertices = std::move(vs);
+    edges = std::move(es);
+    vertex_degrees();
+}
+
+pmc_graph::pmc_graph(span<const long long> vs, span<const int> es) {
+    initialize();
+    if (is_canonical_csr(vs, es)) {
+        vertices = vs;
+        edges = es;
+    }
+    else {
+        vector<long long> V(vs.begin(), vs.end());
+        vector<int> E(es.begin(), es.end());
+        canonicalize_csr(V, E);
+        vertices = std::move(V);
+        edges = std::move(E);
+    }
+    vertex_degrees();
+}
+
+pmc_graph::pmc_graph(span<const long long> vs, span<const int> es, canonical_csr_t) {
+    initialize();
+    vertices = vs;
+    edges = es;
+    vertex_degrees();
 }
 
 pmc_graph::pmc_graph(long long nedges, const int *ei, const int *ej, int offset) {
     initialize();
-    map< int, vector<int> > vert_list;
-    for (long long i = 0; i < nedges; i++) {
-        int v = ei[i] - offset;
-        int u = ej[i] - offset;
-        if ( v > u ) {
-            vert_list[v].push_back(u);
-            vert_list[u].push_back(v);
+    graph_builder builder;
+
+    // both directions of an edge may be given, the builder keeps it once
+    #pragma omp parallel
+    {
+        edge_buffer& buf = builder.get_buffer();
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < nedges; i++) {
+            const int v = ei[i] - offset;
+            const int u = ej[i] - offset;
+            if (v >= 0 && u >= 0)  buf.add_edge(v, u);
         }
     }
-    vertices.push_back(edges.size());
-    for (int i=0; i < vert_list.size(); i++) {
-        edges.insert(edges.end(),vert_list[i].begin(),vert_list[i].end());
-        vertices.push_back(edges.size());
-    }
-    vert_list.clear();
+    build(builder);
+}
+
+pmc_graph::pmc_graph(graph_builder& builder) {
+    initialize();
+    build(builder);
+}
+
+void pmc_graph::build(graph_builder& builder) {
+    vector<long long> V;
+    vector<int> E;
+    builder.finalize(V, E);
+    vertices = std::move(V);
+    edges = std::move(E);
     vertex_degrees();
 }
 
 pmc_graph::pmc_graph(const map<int, vector<int>>& v_map) {
-  vertices.push_back(edges.size());
+  initialize();
+  vector<long long> V;
+  vector<int> E;
+  V.push_back(E.size());
   for (const auto& v_pair : v_map) {
-    edges.insert(edges.end(), v_pair.second.begin(), v_pair.second.end());
-    vertices.push_back(edges.size());
+    E.insert(E.end(), v_pair.second.begin(), v_pair.second.end());
+    V.push_back(E.size());
   }
+  canonicalize_csr(V, E);
+  vertices = std::move(V);
+  edges = std::move(E);
   vertex_degrees();
 }
 
-void pmc_graph::read_mtx(const string& filename) {
-    float connStrength = std::numeric_limits<float>::lowest();
-    istringstream in2;
-    string line="";
-    map<int,vector<int> > v_map;
-    map<int,vector<double> > valueList;
-    int col=0, row=0, ridx=0, cidx=0;
-    int entry_counter = 0, num_of_entries = 0;
-    double value;
-
-    ifstream in (filename.c_str());
-    if(!in) {
+void pmc_graph::read_mtx(const string& filename, edge_filter* filter) {
+    line_reader in(filename);
+    if (!in.is_open()) {
         cout<<filename<<" not Found!"<<endl;
         return;
     }
+    double sec = get_time();
+
+    int col=0, row=0;
+    long long num_of_entries = 0;
 
     char data[LINE_LENGTH];
     char banner[LINE_LENGTH];
@@ -197,82 +539,111 @@ void pmc_graph::read_mtx(const string& filename) {
     char crd[LINE_LENGTH];
     char data_type[LINE_LENGTH];
     char storage_scheme[LINE_LENGTH];
-    char* p;
+    char* s;
     bool b_getValue = true;
 
-    getline(in, line);
-    strcpy(data, line.c_str());
-    if (sscanf(data, "%s %s %s %s %s", banner, mtx, crd, data_type, storage_scheme) != 5) {
-        cout << "ERROR: mtx header is missing" << endl;
-        return;
-    }
-
-    for (p=data_type; *p!='\0'; *p=tolower(*p),p++);
-
-    if (strcmp(data_type, "pattern") == 0)  b_getValue = false;
-
-    getline(in, line);
-    while(line.size()>0&&line[0]=='%') getline(in,line);
-    in2.str(line);
-    in2 >> row >> col >> num_of_entries;
-
-    if(row!=col) {
-        cout<<"* ERROR: This is not a square matrix."<<endl;
-        return;
-    }
-
-    while(!in.eof() && entry_counter<num_of_entries) {
-        getline(in,line);
-        entry_counter++;
-
-        if(line!="") {
-            in2.clear();
-            in2.str(line);
-            in2 >> ridx >> cidx >> value;
-            ridx--;
-            cidx--;
-
-            if (ridx < 0 || ridx >= row)  cout << "sym-mtx error: " << ridx << " row " << row << endl;
-            if (cidx < 0 || cidx >= col)  cout << "sym-mtx error: " << cidx << " col " << col << endl;
-            if (ridx == cidx)  continue;
-
-            if (ridx > cidx) {
-                if (b_getValue) {
-                    if(value > connStrength) {
-                        v_map[ridx].push_back(cidx);
-                        v_map[cidx].push_back(ridx);
-                        if (is_gstats) {
-                            e_v.push_back(ridx);
-                            e_u.push_back(cidx);
-                        }
-                    }
-                } else {
-                    v_map[ridx].push_back(cidx);
-                    v_map[cidx].push_back(ridx);
-                    if (is_gstats) {
-                        e_v.push_back(ridx);
-                        e_u.push_back(cidx);
-                    }
+    int header_lines = 0;           // banner, then the size line after the comments
+    vector<edge_chunk> chunks;
+    long long entry_counter = 0, self_edges = 0, bad_ids = 0;
+    bool done = false;
+    const char *p, *end;
+
+    while (!done && in.next(p, end)) {
+        while (header_lines < 2 && p < end) {
+            const char* eol = line_end(p, end);
+            if (header_lines == 0) {
+                size_t header_len = std::min<size_t>(eol - p, LINE_LENGTH - 1);
+                memcpy(data, p, header_len);
+                data[header_len] = '\0';
+                if (sscanf(data, "%s %s %s %s %s", banner, mtx, crd, data_type, storage_scheme) != 5) {
+                    cout << "ERROR: mtx header is missing" << endl;
+                    return;
                 }
 
-                if (b_getValue && value > connStrength) {
-                    valueList[ridx].push_back(value);
-                    valueList[cidx].push_back(value);
+                for (s=data_type; *s!='\0'; *s=tolower(*s),s++);
+
+                if (strcmp(data_type, "pattern") == 0)  b_getValue = false;
+                header_lines = 1;
+            }
+            else if (*p != '%') {
+                long long r = 0, c = 0;
+                if (parse_int(p, eol, r) && parse_int(p, eol, c))
+                    parse_int(p, eol, num_of_entries);
+                row = r;
+                col = c;
+                header_lines = 2;
+
+                if(row!=col) {
+                    cout<<"* ERROR: This is not a square matrix."<<endl;
+                    return;
                 }
-            } else {
-                cout << "* WARNING: Found a nonzero in the upper triangular. ";
+            }
+            p = next_line(p, end);
+        }
+        if (header_lines < 2)  continue;
+
+        // parse line-aligned chunks of this block in parallel
+        vector<const char*> bounds = split_lines(p, end, num_parse_chunks(end - p, omp_get_max_threads()));
+        size_t num_chunks = bounds.size() - 1, first = chunks.size();
+        chunks.resize(first + num_chunks);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t i = 0; i < num_chunks; i++)
+            parse_mtx_chunk(bounds[i], bounds[i+1], row, b_getValue,
+                    std::numeric_limits<long long>::max(), chunks[first + i]);
+
+        // keep only the first num_of_entries entries
+        for (size_t i = 0; i < num_chunks; i++) {
+            edge_chunk& chunk = chunks[first + i];
+            if (entry_counter + chunk.entries > num_of_entries) {
+                chunk = edge_chunk();
+                parse_mtx_chunk(bounds[i], bounds[i+1], row, b_getValue,
+                        num_of_entries - entry_counter, chunk);
+            }
+            entry_counter += chunk.entries;
+            self_edges += chunk.self_loops;
+            bad_ids += chunk.bad_ids;
+            if (entry_counter >= num_of_entries) {
+                chunks.resize(first + i + 1);
+                done = true;
                 break;
             }
         }
+        if (filter != nullptr) {
+            if (filter->count_only)  filter->degree.resize(row, 0);
+            filter_chunks(chunks, first, filter->count_only, filter->degree, filter->keep);
+        }
+    }
+    if (header_lines == 0) {
+        cout << "ERROR: mtx header is missing" << endl;
+        return;
     }
-    vertices.push_back(edges.size());
-    for (int i=0;i < row; i++) {
-        edges.insert(edges.end(),v_map[i].begin(),v_map[i].end());
-        vertices.push_back(edges.size());
+    if (!done && in.error())  cout << "* WARNING: " << filename << " is corrupt, reading stopped early" << endl;
+    if (filter != nullptr && filter->count_only)  return;
+    if (bad_ids > 0)  cout << "sym-mtx error: " << bad_ids << " entries out of range " << row << endl;
+
+    if (is_gstats) {
+        for (size_t i = 0; i < chunks.size(); i++) {
+            const vector<int>& e = chunks[i].pairs;
+            for (size_t j = 0; j < e.size(); j += 2) {
+                e_v.push_back(e[j]);
+                e_u.push_back(e[j+1]);
+            }
+        }
     }
-    v_map.clear();
-    valueList.clear();
+
+    vector<long long> V;
+    vector<int> E;
+    // entries of both triangles are mirrored, an edge listed in both is kept once
+    long long duplicates = build_csr(row, chunk_pairs(chunks), 0, V, E);
+    chunks.clear();
+    vertices = std::move(V);
+    edges = std::move(E);
     vertex_degrees();
+    if (duplicates > 0)  cout << "duplicate edges: " << duplicates <<endl;
+
+    double parse_sec = get_time() - sec;
+    cout << "Parse throughput: " << (in.bytes() / 1048576.0) / parse_sec << " MB/s" << endl;
 }
 
 void pmc_graph::create_adj() {
@@ -280,15 +651,14 @@ void pmc_graph::create_adj() {
 
     int size = num_vertices();
     adj.resize(size);
-    for (int i = 0; i < size; i++) {
-        adj[i].resize(size);
-    }
 
-    for (int i = 0; i < num_vertices(); i++) {
+    // each row is filled by one thread
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < size; i++) {
         for (long long j = vertices[i]; j < vertices[i + 1]; j++ )
-            adj[i][edges[j]] = true;
+            adj.set(i, edges[j]);
     }
-    DEBUG_PRINTF("Created adjacency matrix in %i seconds\n", get_time() - sec);
+    DEBUG_PRINTF("Created adjacency matrix (%.1f MB) in %i seconds\n", adj.size_bytes() / 1048576.0, get_time() - sec);
 }
 
 
@@ -298,7 +668,7 @@ void pmc_graph::sum_vertex_degrees() {
     uint64_t sum = 0;
     for (long long v = 0; v < n; v++) {
         degree[v] = vertices[v+1] - vertices[v];
-        sum += (degree[v] * degree[v]-1) / 2;
+        sum += ((uint64_t)degree[v] * degree[v] - 1) / 2;
     }
     cout << "sum of degrees: " << sum <<endl;
 }
@@ -308,10 +678,11 @@ void pmc_graph::vertex_degrees() {
     degree.resize(n);
 
     // initialize min and max to degree of first vertex
-    min_degree = static_cast<int>(vertices[1]) - static_cast<int>(vertices[0]);
-    max_degree = static_cast<int>(vertices[1]) - static_cast<int>(vertices[0]);
+    // offsets may exceed 2^31, only their differences fit in an int
+    min_degree = static_cast<int>(vertices[1] - vertices[0]);
+    max_degree = static_cast<int>(vertices[1] - vertices[0]);
     for (int v=0; v<n; v++) {
-        degree[v] = static_cast<int>(vertices[v+1]) - static_cast<int>(vertices[v]);
+        degree[v] = static_cast<int>(vertices[v+1] - vertices[v]);
         if (max_degree < degree[v])  {
             max_degree = degree[v];
         }
@@ -365,79 +736,30 @@ void pmc_graph::update_degrees(bool_vector& pruned, int& mc) {
 }
 
 
+/**
+ * Brings the k-cores up to date with the unpruned vertices
+ *   + the first call starts the maintained cores (core_maintenance) from the current CSR,
+ *     later calls only remove the vertices pruned since and follow the change
+ *   + kcore is rewritten only for the vertices whose core moved, pruned vertices get 0;
+ *     kcore_order is left as it is
+ */
 void pmc_graph::update_kcores(const bool_vector& pruned) {
-
-    long long n, d, i, j, start, num, md;
-    long long v, u, w, du, pu, pw, md_end;
-    n = vertices.size();
-    kcore.resize(n);
-    fill(kcore.begin(), kcore.end(), 0);
-    vector <int> pos_tmp(n);
-    vector <int> order_tmp(n);
-
-    md = 0;
-    for(v=1; v<n; v++) {
-        if (!pruned[v-1]) {
-            kcore[v] = degree[v-1];
-            if (kcore[v] > md)  md = kcore[v];
-        }
-    }
-
-    md_end = md+1;
-    vector < int > bin(md_end,0);
-
-    for (v=1; v < n; v++)  bin[kcore[v]]++;
-
-    start = 1;
-    for (d=0; d < md_end; d++) {
-        num = bin[d];
-        bin[d] = start;
-        start = start + num;
-    }
-
-    for (v=1; v<n; v++) {
-        pos_tmp[v] = bin[kcore[v]];
-        order_tmp[pos_tmp[v]] = v;
-        bin[kcore[v]]++;
-    }
-
-    for (d=md; d > 1; d--)  bin[d] = bin[d-1];
-    bin[0] = 1;
-
-    for (i = 1; i < n; i++) {
-        v=order_tmp[i];
-        if (!pruned[v-1]) {
-            for (j = vertices[v-1]; j < vertices[v]; j++) {
-                if (!pruned[edges[j]]) {
-                    u = edges[j] + 1;
-                    if (kcore[u] > kcore[v]) {
-                        du = kcore[u];   pu = pos_tmp[u];
-                        pw = bin[du];  w = order_tmp[pw];
-                        if (u != w) {
-                            pos_tmp[u] = pw;   order_tmp[pu] = w;
-                            pos_tmp[w] = pu;   order_tmp[pw] = u;
-                        }
-                        bin[du]++;   kcore[u]--;
-                    }
-                }
-            }
-        }
-    }
-
-    max_core = 0;
-    for (v=0; v<n-1; v++) {
-        if (!pruned[v]) {
-            kcore[v] = kcore[v+1] + 1; // K+1
-            order_tmp[v] = order_tmp[v+1]-1;
-            if (kcore[v] > max_core)  max_core = kcore[v];
-        }
-        else kcore[v] = 0;
-    }
-    DEBUG_PRINTF("[pmc: updated cores]  K: %i\n", max_core);
-
-    bin.clear();
-    pos_tmp.clear();
-    order_tmp.clear();
+    if (edges.empty() && compressed != nullptr)  return;
+    if (kcore.size() != vertices.size())  compute_cores();
+    if (dynamic_cores == nullptr)
+        dynamic_cores = std::make_shared<core_maintenance>(vertices, edges, kcore);
+
+    vector<int> newly;
+    for (int v = 0; v < num_vertices(); v++)
+        if (pruned[v] && !dynamic_cores->is_removed(v))  newly.push_back(v);
+    dynamic_cores->remove_vertices(newly);
+
+    vector<int> changed;
+    dynamic_cores->take_changed(changed);
+    for (int v : changed)
+        kcore[v] = dynamic_cores->is_removed(v) ? 0 : dynamic_cores->core_number(v) + 1;
+    max_core = dynamic_cores->max_core();
+    DEBUG_PRINTF("[pmc: updated cores]  K: %i, changed: %zu\n", max_core, changed.size());
 }
 
 
@@ -454,11 +776,12 @@ string pmc_graph::get_file_extension(const string& filename) {
 
 
 void pmc_graph::reduce_graph(const bool_vector& pruned) {
+    dynamic_cores.reset();
     vector<long long> V(vertices.size(),0);
     vector<int> E;
     E.reserve(edges.size());
 
-    int start = 0;
+    long long start = 0;
     for (int i = 0; i < num_vertices(); i++) {
         start = E.size();
         if (!pruned[i]) {
@@ -470,14 +793,14 @@ void pmc_graph::reduce_graph(const bool_vector& pruned) {
         V[i] = start;
         V[i + 1] = E.size();
     }
-    vertices = V;
-    edges = E;
+    vertices = std::move(V);
+    edges = std::move(E);
 }
 
 
 void pmc_graph::reduce_graph(
-        vector<long long>& vs,
-        vector<int>& es,
+        csr_array<long long>& vs,
+        csr_array<int>& es,
         const bool_vector& pruned) {
 
     int num_vs = vs.size();
@@ -486,7 +809,7 @@ void pmc_graph::reduce_graph(
     vector<int> E;
     E.reserve(es.size());
 
-    int start = 0;
+    long long start = 0;
     for (int i = 0; i < num_vs - 1; i++) {
         start = E.size();
         if (!pruned[i]) { //skip these V_local...
@@ -498,8 +821,8 @@ void pmc_graph::reduce_graph(
         V[i] = start;
         V[i + 1] = E.size();
     }
-    vs = V;
-    es = E;
+    vs = std::move(V);
+    es = std::move(E);
 }
 
 
@@ -613,7 +936,7 @@ void pmc_graph::degree_bucket_sort(bool desc) {
     }
 
     DEBUG_PRINTF("[pmc: sorting neighbors]  |E| = %i, |E_sorted| = %i\n", edges.size(), tmp_edges.size());
-    edges = tmp_edges;
+    edges = std::move(tmp_edges);
 }
 
 
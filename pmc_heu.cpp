@@ -20,13 +20,14 @@
 #include "pmc/pmc_bool_vector.h"
 #include "pmc/pmc_debug_utils.h"
 #include "pmc/pmc_heu.h"
+#include "pmc/pmc_intersect.h"
 
 #include <algorithm>
 
 using namespace pmc;
 
 
-void pmc_heu::branch(std::vector<Vertex>& P, int sz,
+void pmc_heu::branch(std::vector<Vertex>& P, std::vector<int>& Ps, int sz,
         int& mc, std::vector<int>& C, bool_vector& ind) {
 
     if (!P.empty()) {
@@ -34,7 +35,10 @@ void pmc_heu::branch(std::vector<Vertex>& P, int sz,
         const int u = P.back().get_id();
         P.pop_back();
 
-        for (long long j = (*V)[u]; j < (*V)[u + 1]; j++)  ind[(*E)[j]] = true;
+        // N(u) and P meet in Rs, u is not a neighbor of itself
+        std::vector<int> Rs(Ps.size());
+        Rs.resize(common_neighbors(csr_adjacency(*V, *E), u, Ps, Rs.data()));
+        for (int w : Rs)  ind[w] = true;
 
         std::vector<Vertex> R;
         R.reserve(P.size());
@@ -44,14 +48,18 @@ void pmc_heu::branch(std::vector<Vertex>& P, int sz,
                        return ind[v.get_id()] && (*K)[v.get_id()] > mc;
                      });
 
-        for (long long j = (*V)[u]; j < (*V)[u + 1]; j++)  ind[(*E)[j]] = false;
+        for (int w : Rs)  ind[w] = false;
+        Rs.erase(std::remove_if(Rs.begin(), Rs.end(),
+                                [this, mc](int w) { return (*K)[w] <= mc; }),
+                 Rs.end());
 
         const int mc_prev = mc;
-        branch(R, sz + 1, mc, C, ind);
+        branch(R, Rs, sz + 1, mc, C, ind);
 
         if (mc > mc_prev)  C.push_back(u);
 
         P.clear();
+        Ps.clear();
     }
     else if (sz > mc)
         mc = sz;
@@ -64,6 +72,7 @@ int pmc_heu::search_bounds(const pmc_graph& G, std::vector<int>& C_max) {
 
     std::vector<int> C;
     std::vector<Vertex> P;
+    std::vector<int> Ps;
 
     C_max.reserve(ub);
     C.reserve(ub);
@@ -76,7 +85,7 @@ int pmc_heu::search_bounds(const pmc_graph& G, std::vector<int>& C_max) {
 
     #pragma omp parallel for schedule(dynamic) \
         shared(G, mc, C_max, found_ub) \
-        private(P, C) firstprivate(ind) \
+        private(P, Ps, C) firstprivate(ind) \
         num_threads(num_threads)
     for (int i = G.num_vertices()-1; i >= 0; --i) {
         bool found_ub_local = false;
@@ -96,13 +105,19 @@ int pmc_heu::search_bounds(const pmc_graph& G, std::vector<int>& C_max) {
         }
 
         if ((*K)[v] > mc_cur) {
+            // P of the last root is left over when it was too small
+            P.clear();
+            Ps.clear();
             for (long long j = (*V)[v]; j < (*V)[v + 1]; j++)
-                if ((*K)[(*E)[j]] > mc_cur)
+                if ((*K)[(*E)[j]] > mc_cur) {
                     P.emplace_back((*E)[j], compute_heuristic((*E)[j]));
+                    Ps.push_back((*E)[j]);
+                }
 
             if (P.size() > mc_cur) {
+                // Ps keeps the sorted order of the neighbor list
                 std::sort(P.begin(), P.end(), incr_heur);
-                branch(P, 1 , mc_cur, C, ind);
+                branch(P, Ps, 1 , mc_cur, C, ind);
 
                 if (mc_cur >= ub) {
                     #pragma omp atomic write release
@@ -142,6 +157,7 @@ int pmc_heu::compute_heuristic(int v) {
 int pmc_heu::search_cores(const pmc_graph& G, std::vector<int>& C_max, int lb) {
     std::vector <int> C;
     std::vector<Vertex> P;
+    std::vector<int> Ps;
 
     C_max.reserve(ub);
     C.reserve(ub);
@@ -159,7 +175,7 @@ int pmc_heu::search_cores(const pmc_graph& G, std::vector<int>& C_max, int lb) {
 
     #pragma omp parallel for schedule(dynamic) \
         shared(G, mc, C_max) \
-        private(P, C) firstprivate(ind) \
+        private(P, Ps, C) firstprivate(ind) \
         num_threads(num_threads)
     for (int i = lb_idx; i < G.num_vertices(); i++) {
         const int v = (*order)[i];
@@ -171,13 +187,19 @@ int pmc_heu::search_cores(const pmc_graph& G, std::vector<int>& C_max, int lb) {
         }
 
         if ((*K)[v] > mc_cur) {
+            // P of the last root is left over when it was too small
+            P.clear();
+            Ps.clear();
             for (long long j = (*V)[v]; j < (*V)[v + 1]; j++)
-                if ((*K)[(*E)[j]] > mc_cur)
+                if ((*K)[(*E)[j]] > mc_cur) {
                     P.emplace_back((*E)[j], compute_heuristic((*E)[j]));
+                    Ps.push_back((*E)[j]);
+                }
 
             if (P.size() > mc_cur) {
+                // Ps keeps the sorted order of the neighbor list
                 std::sort(P.begin(), P.end(), incr_heur);
-                branch(P, 1 , mc_cur, C, ind);
+                branch(P, Ps, 1 , mc_cur, C, ind);
 
                 if (mc_cur > mc_prev) {
                     C.push_back(v);
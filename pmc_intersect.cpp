@@ -0,0 +1,180 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_intersect.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PMC_INTERSECT_X86
+#include <immintrin.h>
+#endif
+
+using namespace pmc;
+
+int pmc::intersect_merge(const int* a, int na, const int* b, int nb, int* out) {
+    int i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j])  i++;
+        else if (b[j] < a[i])  j++;
+        else {
+            out[k++] = a[i];
+            i++;  j++;
+        }
+    }
+    return k;
+}
+
+int pmc::intersect_gallop(const int* a, int na, const int* b, int nb, int* out) {
+    int k = 0, pos = 0;
+    for (int i = 0; i < na && pos < nb; i++) {
+        const int x = a[i];
+        // b[pos + step/2] < x, so x is in b[pos + step/2 .. pos + step]
+        int step = 1;
+        while (pos + step < nb && b[pos + step] < x)  step <<= 1;
+        const int* first = b + pos + (step >> 1);
+        const int* last = b + std::min(pos + step + 1, nb);
+        pos = std::lower_bound(first, last, x) - b;
+        if (pos < nb && b[pos] == x) {
+            out[k++] = x;
+            pos++;
+        }
+    }
+    return k;
+}
+
+#ifdef PMC_INTERSECT_X86
+
+__attribute__((target("sse4.2")))
+int pmc::intersect_sse(const int* a, int na, const int* b, int nb, int* out) {
+    int i = 0, j = 0, k = 0;
+    while (i + 4 <= na && j + 4 <= nb) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        const __m128i m = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                    _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+                _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                    _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        for (int mask = _mm_movemask_ps(_mm_castsi128_ps(m)); mask; mask &= mask - 1)
+            out[k++] = a[i + __builtin_ctz(mask)];
+
+        const int amax = a[i + 3], bmax = b[j + 3];
+        if (amax <= bmax)  i += 4;
+        if (bmax <= amax)  j += 4;
+    }
+    return k + intersect_merge(a + i, na - i, b + j, nb - j, out + k);
+}
+
+__attribute__((target("avx2")))
+int pmc::intersect_avx2(const int* a, int na, const int* b, int nb, int* out) {
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    int i = 0, j = 0, k = 0;
+    while (i + 8 <= na && j + 8 <= nb) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i m = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; r++) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, vb));
+        }
+        for (int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m)); mask; mask &= mask - 1)
+            out[k++] = a[i + __builtin_ctz(mask)];
+
+        const int amax = a[i + 7], bmax = b[j + 7];
+        if (amax <= bmax)  i += 8;
+        if (bmax <= amax)  j += 8;
+    }
+    return k + intersect_merge(a + i, na - i, b + j, nb - j, out + k);
+}
+
+__attribute__((target("avx512f")))
+int pmc::intersect_avx512(const int* a, int na, const int* b, int nb, int* out) {
+    const __m512i rotate = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0);
+    int i = 0, j = 0, k = 0;
+    while (i + 16 <= na && j + 16 <= nb) {
+        const __m512i va = _mm512_loadu_si512(a + i);
+        __m512i vb = _mm512_loadu_si512(b + j);
+        __mmask16 m = _mm512_cmpeq_epi32_mask(va, vb);
+        for (int r = 1; r < 16; r++) {
+            vb = _mm512_maskz_permutexvar_epi32(0xffff, rotate, vb);
+            m |= _mm512_cmpeq_epi32_mask(va, vb);
+        }
+        _mm512_mask_compressstoreu_epi32(out + k, m, va);
+        k += __builtin_popcount(m);
+
+        const int amax = a[i + 15], bmax = b[j + 15];
+        if (amax <= bmax)  i += 16;
+        if (bmax <= amax)  j += 16;
+    }
+    return k + intersect_merge(a + i, na - i, b + j, nb - j, out + k);
+}
+
+intersect_kernel pmc::best_intersect_kernel() {
+    static const intersect_kernel best = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))  return INTERSECT_AVX512;
+        if (__builtin_cpu_supports("avx2"))  return INTERSECT_AVX2;
+        if (__builtin_cpu_supports("sse4.2"))  return INTERSECT_SSE;
+        return INTERSECT_MERGE;
+    }();
+    return best;
+}
+
+#else
+
+// no block kernels, the merge stands in for them
+int pmc::intersect_sse(const int* a, int na, const int* b, int nb, int* out) { return intersect_merge(a, na, b, nb, out); }
+int pmc::intersect_avx2(const int* a, int na, const int* b, int nb, int* out) { return intersect_merge(a, na, b, nb, out); }
+int pmc::intersect_avx512(const int* a, int na, const int* b, int nb, int* out) { return intersect_merge(a, na, b, nb, out); }
+
+intersect_kernel pmc::best_intersect_kernel() { return INTERSECT_MERGE; }
+
+#endif
+
+const char* pmc::intersect_kernel_name(intersect_kernel k) {
+    switch (k) {
+        case INTERSECT_SSE:     return "sse";
+        case INTERSECT_AVX2:    return "avx2";
+        case INTERSECT_AVX512:  return "avx512";
+        default:                return "merge";
+    }
+}
+
+int pmc::intersect_sorted(const int* a, int na, const int* b, int nb, int* out) {
+    typedef int (*kernel)(const int*, int, const int*, int, int*);
+    // AVX-512 is left to the benchmark, its 15 rotations per block keep the
+    // permute unit busy and it timed no faster than AVX2 (pmc_intersect_bench)
+    static const kernel block = [] {
+        switch (best_intersect_kernel()) {
+            case INTERSECT_AVX512:
+            case INTERSECT_AVX2:    return &intersect_avx2;
+            case INTERSECT_SSE:     return &intersect_sse;
+            default:                return &intersect_merge;
+        }
+    }();
+
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (na == 0)  return 0;
+    if ((long long)na * intersect_gallop_ratio < nb)  return intersect_gallop(a, na, b, nb, out);
+    return block(a, na, b, nb, out);
+}
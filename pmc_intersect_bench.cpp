@@ -0,0 +1,115 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_intersect.h"
+#include "pmc/pmc_utils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+/**
+ * Times the intersection kernels of pmc_intersect.h against the scatter the
+ * branch routines used before: N(v) marked in ind, P filtered, N(v) unmarked.
+ * Sizes go from balanced lists to |P| much smaller than deg(v).
+ */
+
+namespace {
+    vector<int> sorted_sample(mt19937& rng, int universe, int size) {
+        vector<int> ids(universe);
+        for (int i = 0; i < universe; i++)  ids[i] = i;
+        shuffle(ids.begin(), ids.end(), rng);
+        ids.resize(size);
+        sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    template <class F>
+    double time_per_call(int reps, F f, int& count) {
+        double sec = get_time();
+        for (int r = 0; r < reps; r++)  count = f();
+        return (get_time() - sec) / reps * 1e9;
+    }
+}
+
+int main() {
+    const int universe = 1 << 20;
+    const int sizes[][2] = { {16, 16}, {64, 64}, {256, 256}, {1024, 1024}, {4096, 4096},
+                             {64, 512}, {64, 2048}, {16, 4096}, {8, 65536} };
+    mt19937 rng(1);
+    vector<short> ind(universe, 0);
+    const bool x86 = best_intersect_kernel() != INTERSECT_MERGE;
+
+    printf("best block kernel: %s, galloping from ratio %i\n",
+            intersect_kernel_name(best_intersect_kernel()), intersect_gallop_ratio);
+    printf("%6s %6s %8s | %9s %9s %9s %9s %9s %9s %9s   (ns per call)\n",
+            "|P|", "deg", "common", "scatter", "merge", "gallop", "sse", "avx2", "avx512", "dispatch");
+
+    for (auto& s : sizes) {
+        // half of P is drawn from N(v) so the lists share ids
+        vector<int> N = sorted_sample(rng, universe, s[1]);
+        vector<int> P = sorted_sample(rng, universe, s[0] - s[0] / 2);
+        for (int i = 0; i < s[0] / 2; i++)  P.push_back(N[(i * 7919) % N.size()]);
+        sort(P.begin(), P.end());
+        P.erase(unique(P.begin(), P.end()), P.end());
+
+        const int reps = max(100, (1 << 24) / (s[0] + s[1]));
+        vector<int> out(P.size());
+        int c[7];
+
+        double t[7];
+        t[0] = time_per_call(reps, [&] {
+            int k = 0;
+            for (int w : N)  ind[w] = 1;
+            for (int u : P)  if (ind[u])  out[k++] = u;
+            for (int w : N)  ind[w] = 0;
+            return k;
+        }, c[0]);
+        t[1] = time_per_call(reps, [&] { return intersect_merge(P.data(), P.size(), N.data(), N.size(), out.data()); }, c[1]);
+        t[2] = time_per_call(reps, [&] { return intersect_gallop(P.data(), P.size(), N.data(), N.size(), out.data()); }, c[2]);
+        t[3] = t[4] = t[5] = 0;
+        c[3] = c[4] = c[5] = c[0];
+        const intersect_kernel best = best_intersect_kernel();
+        if (x86)
+            t[3] = time_per_call(reps, [&] { return intersect_sse(P.data(), P.size(), N.data(), N.size(), out.data()); }, c[3]);
+        if (best == INTERSECT_AVX2 || best == INTERSECT_AVX512)
+            t[4] = time_per_call(reps, [&] { return intersect_avx2(P.data(), P.size(), N.data(), N.size(), out.data()); }, c[4]);
+        if (best == INTERSECT_AVX512)
+            t[5] = time_per_call(reps, [&] { return intersect_avx512(P.data(), P.size(), N.data(), N.size(), out.data()); }, c[5]);
+        t[6] = time_per_call(reps, [&] { return intersect_sorted(P.data(), P.size(), N.data(), N.size(), out.data()); }, c[6]);
+
+        for (int k = 1; k < 7; k++) {
+            if (c[k] != c[0]) {
+                printf("kernel %i found %i common ids, the scatter %i\n", k, c[k], c[0]);
+                return 1;
+            }
+        }
+        printf("%6zu %6zu %8i |", P.size(), N.size(), c[0]);
+        for (int k = 0; k < 7; k++) {
+            if (t[k] > 0)  printf(" %9.1f", t[k]);
+            else  printf(" %9s", "-");
+        }
+        printf("\n");
+    }
+    return 0;
+}
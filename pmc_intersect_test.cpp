@@ -0,0 +1,101 @@
+#include "pmc/pmc_intersect.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// Every intersection kernel against std::set_intersection, on sorted lists
+// of many shapes. The block kernels run only when the CPU has them.
+
+namespace {
+
+typedef int (*kernel)(const int*, int, const int*, int, int*);
+
+void fail(const char* what, size_t na, size_t nb) {
+    fprintf(stderr, "Test failed: %s, |a| = %zu, |b| = %zu\n", what, na, nb);
+    exit(-1);
+}
+
+// size distinct ids below universe, in increasing order
+vector<int> sorted_sample(mt19937& rng, int universe, int size) {
+    vector<int> ids(universe);
+    for (int i = 0; i < universe; i++)  ids[i] = i;
+    for (int i = 0; i < size; i++)  swap(ids[i], ids[i + rng() % (universe - i)]);
+    ids.resize(size);
+    sort(ids.begin(), ids.end());
+    return ids;
+}
+
+void check(const char* name, kernel f, const vector<int>& a, const vector<int>& b) {
+    vector<int> expected;
+    set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(expected));
+    // one guard entry past min(|a|, |b|) catches writes beyond the result
+    vector<int> out(min(a.size(), b.size()) + 1, -1);
+    const int k = f(a.data(), a.size(), b.data(), b.size(), out.data());
+    if (k != (int)expected.size() || !equal(expected.begin(), expected.end(), out.begin()))
+        fail(name, a.size(), b.size());
+    if (out[min(a.size(), b.size())] != -1)  fail(name, a.size(), b.size());
+}
+
+vector< pair<const char*, kernel> > kernels() {
+    vector< pair<const char*, kernel> > ks = {
+        { "merge", &intersect_merge },
+        { "gallop", &intersect_gallop },
+        { "intersect_sorted", &intersect_sorted } };
+    const intersect_kernel best = best_intersect_kernel();
+    if (best >= INTERSECT_SSE)  ks.push_back({ "sse", &intersect_sse });
+    if (best >= INTERSECT_AVX2)  ks.push_back({ "avx2", &intersect_avx2 });
+    if (best >= INTERSECT_AVX512)  ks.push_back({ "avx512", &intersect_avx512 });
+    return ks;
+}
+
+}
+
+void test_edge_cases() {
+    vector<int> empty, a, odd, even, low, high;
+    for (int i = 0; i < 100; i++)  a.push_back(3 * i);
+    for (int i = 0; i < 50; i++) {
+        odd.push_back(2 * i + 1);
+        even.push_back(2 * i);
+        low.push_back(i);
+        high.push_back(1000 + i);
+    }
+    for (auto& k : kernels()) {
+        check(k.first, k.second, empty, empty);
+        check(k.first, k.second, empty, a);
+        check(k.first, k.second, a, empty);
+        check(k.first, k.second, a, a);
+        check(k.first, k.second, odd, even);
+        check(k.first, k.second, low, high);
+        check(k.first, k.second, high, low);
+        check(k.first, k.second, vector<int>(1, 297), a);
+        check(k.first, k.second, a, vector<int>(1, 0));
+    }
+}
+
+void test_random() {
+    mt19937 rng(3);
+    // balanced, skewed both ways, and one list far longer than the other
+    const int sizes[][2] = { {1, 1}, {5, 7}, {16, 16}, {17, 33}, {64, 64}, {100, 1000},
+                             {1000, 100}, {3, 5000}, {5000, 3}, {300, 300}, {2000, 2000} };
+    for (auto& s : sizes) {
+        for (int universe : { 64, 4096, 1 << 20 }) {
+            for (int rep = 0; rep < 4; rep++) {
+                const vector<int> a = sorted_sample(rng, universe, min(s[0], universe));
+                const vector<int> b = sorted_sample(rng, universe, min(s[1], universe));
+                for (auto& k : kernels())  check(k.first, k.second, a, b);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    test_edge_cases();
+    test_random();
+}
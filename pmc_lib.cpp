@@ -19,18 +19,17 @@
 
 #include "pmc/pmc.h"
 
+#include <cstdint>
+
 using namespace std;
 using namespace pmc;
 
-extern "C" {
-    
-// a list of edges, where index_offset is the starting index
-int max_clique(long long nedges, int *ei, int *ej, int index_offset, 
-                int outsize, int *clique) {
+namespace {
+
+// searches G with the default parameters and writes the clique (plus index_offset) to clique
+int solve(pmc_graph& G, int index_offset, int outsize, int *clique) {
     input in;
-    
-    pmc_graph G(nedges, ei, ej, index_offset); 
-    
+
     //! ensure wait time is greater than the time to recompute the graph data structures
     if (G.num_edges() > 1000000000 && in.remove_time < 120)  in.remove_time = 120;
     else if (G.num_edges() > 250000000 && in.remove_time < 10) in.remove_time = 10;
@@ -60,6 +59,10 @@ int max_clique(long long nedges, int *ei, int *ej, int index_offset,
         cout << "Heuristic found optimal solution." << endl;
     }
     else if (in.algorithm >= 0) {
+        // the vertices the initial pruning would remove are dropped first, so the
+        // dense search is picked by (and its matrix built over) the ones left
+        vector<int> H = C;
+        G.compact(in.lb);
         switch(in.algorithm) {
             case 0: {
                 //! k-core pruning, neigh-core pruning/ordering, dynamic coloring bounds/sort
@@ -102,15 +105,94 @@ int max_clique(long long nedges, int *ei, int *ej, int index_offset,
         seconds = (get_time() - seconds);
         cout << "Time taken: " << seconds << " SEC" << endl;
         cout << "Size (omega): " << C.size() << endl;
+        C = (int)C.size() > in.lb ? G.original_ids(C) : H;
         print_max_clique(C);
     }
     
     // save the output
-    for(int i = 0; i < C.size() && i < outsize; i++)
+    for(int i = 0; i < (int)C.size() && i < outsize; i++)
         clique[i] = C[i] + index_offset;
 
     return C.size();
-    return 0;
+}
+
+// copies a CSR of any index width, with ids starting at base, to 0-based ids and
+// 64-bit offsets (pmc_graph makes it canonical). Returns false if an offset or id
+// is out of range.
+template <class Ptr, class Ind>
+bool copy_csr(long long n, const Ptr* colptr, const Ind* rowind, long long base,
+        vector<long long>& vertices, vector<int>& edges) {
+    vertices.resize(n + 1);
+    long long bad = 0;
+    #pragma omp parallel for schedule(static) reduction(+:bad)
+    for (long long v = 0; v <= n; v++) {
+        vertices[v] = colptr[v] - colptr[0];
+        if (v > 0 ? colptr[v] < colptr[v - 1] : colptr[0] < base)  bad++;
+    }
+    if (bad > 0)  return false;
+
+    edges.resize(vertices[n]);
+    const Ind* first = rowind + (colptr[0] - base);
+    #pragma omp parallel for schedule(static) reduction(+:bad)
+    for (long long j = 0; j < (long long)edges.size(); j++) {
+        const long long u = first[j] - base;
+        if (u < 0 || u >= n)  bad++;
+        else edges[j] = static_cast<int>(u);
+    }
+    return bad == 0;
+}
+
+template <class Ptr>
+bool copy_csr(long long n, const Ptr* colptr, const void *rowind, int ind_width, long long base,
+        vector<long long>& vertices, vector<int>& edges) {
+    if (ind_width == 4)
+        return copy_csr(n, colptr, static_cast<const int32_t*>(rowind), base, vertices, edges);
+    return copy_csr(n, colptr, static_cast<const int64_t*>(rowind), base, vertices, edges);
+}
+
+}
+
+extern "C" {
+    
+// a list of edges, where index_offset is the starting index
+int max_clique(long long nedges, int *ei, int *ej, int index_offset, 
+                int outsize, int *clique) {
+    pmc_graph G(nedges, ei, ej, index_offset); 
+    return solve(G, index_offset, outsize, clique);
+}
+
+// a symmetric CSR (or CSC) matrix: the neighbors of vertex v are
+// rowind[colptr[v] - index_offset ... colptr[v+1] - index_offset), both arrays
+// hold ids/offsets starting at index_offset and are ptr_width or ind_width (4 or 8) bytes wide
+int max_clique_csr(long long n, const void *colptr, int ptr_width,
+                const void *rowind, int ind_width, int index_offset,
+                int outsize, int *clique) {
+    if (n < 0 || n >= INT32_MAX || (ptr_width != 4 && ptr_width != 8) || (ind_width != 4 && ind_width != 8)) {
+        cout << "max_clique_csr: unsupported graph size or index width." <<endl;
+        return -1;
+    }
+
+    // the native layout is searched in place, the graph is copied only once it is reduced
+    if (ptr_width == 8 && ind_width == 4 && index_offset == 0) {
+        span<const long long> vs(static_cast<const long long*>(colptr), n + 1);
+        span<const int> es(static_cast<const int*>(rowind), n > 0 ? vs[n] : 0);
+        if (is_canonical_csr(vs, es)) {
+            pmc_graph G(vs, es, canonical_csr_t());
+            return solve(G, index_offset, outsize, clique);
+        }
+    }
+
+    vector<long long> vertices;
+    vector<int> edges;
+    bool ok = ptr_width == 4
+        ? copy_csr(n, static_cast<const int32_t*>(colptr), rowind, ind_width, index_offset, vertices, edges)
+        : copy_csr(n, static_cast<const int64_t*>(colptr), rowind, ind_width, index_offset, vertices, edges);
+    if (!ok) {
+        cout << "max_clique_csr: offset or vertex id out of range." <<endl;
+        return -1;
+    }
+    pmc_graph G(std::move(vertices), std::move(edges));
+    return solve(G, index_offset, outsize, clique);
 }
 
 };
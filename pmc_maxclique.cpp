@@ -18,8 +18,10 @@
  */
 
 #include "pmc/pmc_debug_utils.h"
+#include "pmc/pmc_intersect.h"
 #include "pmc/pmc_maxclique.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace std;
@@ -50,10 +52,11 @@ int pmc_maxclique::search(pmc_graph& G, vector<int>& sol) {
     G.order_vertices(V,G,lb_idx,lb,vertex_ordering,decr_order);
 
     vector<short> ind(G.num_vertices(),0);
+    vector<int> Ps;
 
     #pragma omp parallel for schedule(dynamic) \
-        shared(pruned, G, T, V, mc, C_max) firstprivate(ind) private(u, P, C) num_threads(num_threads)
-    for (i = 0; i < (V.size()) - (mc-1); ++i) {
+        shared(pruned, G, T, V, mc, C_max) firstprivate(ind) private(u, P, Ps, C) num_threads(num_threads)
+    for (i = 0; i < (long long)V.size() - max(mc-1, 0); ++i) {
         if (G.time_left(C_max,sec,time_limit,time_expired_msg)) {
 
             u = V[i].get_id();
@@ -63,9 +66,13 @@ int pmc_maxclique::search(pmc_graph& G, vector<int>& sol) {
                     if (!pruned[(*edges)[j]])
                         if ((*bound)[(*edges)[j]] > mc)
                             P.push_back(Vertex((*edges)[j], (*degree)[(*edges)[j]]));
+                sort_by_degree(P, 1, *degree);
 
                 if (P.size() > mc) {
-                    branch(P, ind, C, C_max, pruned, mc);
+                    Ps.resize(P.size());
+                    for (int k = 0; k < P.size(); k++)  Ps[k] = P[k].get_id();
+                    std::sort(Ps.begin(), Ps.end());
+                    branch(P, Ps, ind, C, C_max, pruned, mc);
                 }
                 P = T;
             }
@@ -84,6 +91,7 @@ int pmc_maxclique::search(pmc_graph& G, vector<int>& sol) {
 
 void pmc_maxclique::branch(
         vector<Vertex> &P,
+        vector<int>& Ps,
         vector<short>& ind,
         vector<int>& C,
         vector<int>& C_max,
@@ -98,19 +106,28 @@ void pmc_maxclique::branch(
                 int v = P.back().get_id();   C.push_back(v);
 
                 vector<Vertex> R;   R.reserve(P.size());
-                for (long long j = (*vertices)[v]; j < (*vertices)[v + 1]; j++)   ind[(*edges)[j]] = 1;
+                vector<int> Rs(Ps.size());
+                Rs.resize(common_neighbors(csr_adjacency(*vertices, *edges), v, Ps, Rs.data()));
+                for (int w : Rs)   ind[w] = 1;
 
                 // intersection of N(v) and P - {v}
                 for (int k = 0; k < P.size() - 1; k++)
                     if (ind[P[k].get_id()])
                         if (!pruned[P[k].get_id()])
-                            if ((*bound)[P[k].get_id()] > mc)
+                            if ((*bound)[P[k].get_id()] > mc) {
                                 R.push_back(P[k]);
+                                ind[P[k].get_id()] = 2;
+                            }
 
-                for (long long j = (*vertices)[v]; j < (*vertices)[v + 1]; j++)  ind[(*edges)[j]] = 0;
+                int r = 0;
+                for (int w : Rs) {
+                    if (ind[w] == 2)  Rs[r++] = w;
+                    ind[w] = 0;
+                }
+                Rs.resize(r);
 
                 if (R.size() > 0) {
-                    branch(R, ind, C, C_max, pruned, mc);
+                    branch(R, Rs, ind, C, C_max, pruned, mc);
                 }
                 else if (C.size() > mc) {
                     // obtain lock
@@ -132,6 +149,7 @@ void pmc_maxclique::branch(
                 C.pop_back();
             }
             else return;
+            Ps.erase(std::lower_bound(Ps.begin(), Ps.end(), P.back().get_id()));
             P.pop_back();
         }
     }
@@ -154,7 +172,9 @@ int pmc_maxclique::search_dense(pmc_graph& G, vector<int>& sol) {
     vertices = &G.get_vertices();
     edges = &G.get_edges();
     degree = G.get_degree();
-    auto adj = G.adj;
+    // G.adj itself, not a copy (see pmcx_maxclique::search_dense)
+    if (G.adj.empty())  G.create_adj();
+    bit_matrix& adj = G.adj;
 
     bool_vector pruned(G.num_vertices());
     int mc = lb, i = 0, u = 0;
@@ -179,7 +199,7 @@ int pmc_maxclique::search_dense(pmc_graph& G, vector<int>& sol) {
 
     #pragma omp parallel for schedule(dynamic) \
         shared(pruned, G, adj, T, V, mc, C_max) firstprivate(ind) private(u, P, C) num_threads(num_threads)
-    for (i = 0; i < (V.size()) - (mc-1); ++i) {
+    for (i = 0; i < (long long)V.size() - max(mc-1, 0); ++i) {
         if (G.time_left(C_max,sec,time_limit,time_expired_msg)) {
 
             u = V[i].get_id();
@@ -189,6 +209,7 @@ int pmc_maxclique::search_dense(pmc_graph& G, vector<int>& sol) {
                     if (!pruned[(*edges)[j]])
                         if ((*bound)[(*edges)[j]] > mc)
                             P.push_back(Vertex((*edges)[j], (*degree)[(*edges)[j]]));
+                sort_by_degree(P, 1, *degree);
 
                 if (P.size() > mc) {
                     branch_dense(P, ind, C, C_max, pruned, mc, adj);
@@ -197,12 +218,13 @@ int pmc_maxclique::search_dense(pmc_graph& G, vector<int>& sol) {
             }
             pruned[u] = true;
             for (long long j = (*vertices)[u]; j < (*vertices)[u + 1]; j++) {
-                adj[u][(*edges)[j]] = false;
-                adj[(*edges)[j]][u] = false;
+                adj.reset(u, (*edges)[j]);
+                adj.reset((*edges)[j], u);
             }
         }
     }
 
+    adj = bit_matrix();
     sol.resize(mc);
     for (int i = 0; i < C_max.size(); i++)  sol[i] = C_max[i];
     G.print_break();
@@ -218,7 +240,7 @@ void pmc_maxclique::branch_dense(
         vector<int>& C_max,
         bool_vector& pruned,
         int& mc,
-        std::vector<bool_vector>& adj) {
+        bit_matrix& adj) {
 
     // stop early if ub is reached
     if (not_reached_ub) {
@@ -230,7 +252,7 @@ void pmc_maxclique::branch_dense(
 
                 for (int k = 0; k < P.size() - 1; k++)
                     // indicates neighbor AND pruned
-                    if (adj[v][P[k].get_id()])
+                    if (adj.test(v, P[k].get_id()))
                         if ((*bound)[P[k].get_id()] > mc)
                             R.push_back(P[k]);
 
@@ -0,0 +1,65 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_mmap.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace pmc;
+using namespace std;
+
+bool mapped_file::open(const string& filename, bool sequential) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    len = static_cast<size_t>(st.st_size);
+    if (len > 0) {
+        void* addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            len = 0;
+            return false;
+        }
+        madvise(addr, len, sequential ? MADV_SEQUENTIAL : MADV_NORMAL);
+        ptr = static_cast<const char*>(addr);
+    }
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    is_mapped = true;
+    return true;
+}
+
+void mapped_file::close() {
+    if (ptr != nullptr)
+        munmap(const_cast<char*>(ptr), len);
+    ptr = nullptr;
+    len = 0;
+    is_mapped = false;
+}
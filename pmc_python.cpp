@@ -0,0 +1,200 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+// Python extension module _pmc, a thin layer over the C API (libpmc.h).
+// Arrays are taken through the buffer protocol (numpy arrays, array.array,
+// memoryviews) without copying, and the GIL is released while the graph is
+// built and searched, so several graphs can be solved from Python threads.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "pmc/pmc.h"
+
+extern "C" {
+#include "libpmc.h"
+}
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+namespace {
+
+    /// Contiguous buffer of 4 or 8 byte integers, released with the object.
+    class int_buffer {
+        private:
+            Py_buffer view;
+            bool held;
+        public:
+            int_buffer() : held(false) {}
+            ~int_buffer() { if (held) PyBuffer_Release(&view); }
+
+            bool get(PyObject* obj, const char* name) {
+                if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+                    return false;
+                held = true;
+                const char* f = view.format == NULL ? "B" : view.format;
+                if (*f == '@' || *f == '=' || *f == '<')  f++;
+                if ((view.itemsize != 4 && view.itemsize != 8) || f[1] != '\0' || strchr("iIlLqQnN", f[0]) == NULL) {
+                    PyErr_Format(PyExc_TypeError, "%s must be an array of 32 or 64-bit integers", name);
+                    return false;
+                }
+                return true;
+            }
+
+            const void* data() const { return view.buf; }
+            int width() const { return static_cast<int>(view.itemsize); }
+            long long size() const { return view.len / view.itemsize; }
+            long long operator[](long long i) const {
+                return view.itemsize == 4 ? static_cast<const int32_t*>(view.buf)[i]
+                                          : static_cast<const int64_t*>(view.buf)[i];
+            }
+    };
+
+    PyObject* clique_list(const vector<int>& clique, int size) {
+        if (size < 0) {
+            PyErr_SetString(PyExc_ValueError, "invalid graph");
+            return NULL;
+        }
+        PyObject* list = PyList_New(size);
+        if (list == NULL)  return NULL;
+        for (int i = 0; i < size; i++)
+            PyList_SET_ITEM(list, i, PyLong_FromLong(clique[i]));
+        return list;
+    }
+
+    // searches a canonical CSR with ids starting at 0, called without the GIL
+    int search_csr(const vector<long long>& vertices, const vector<int>& edges, vector<int>& clique) {
+        const long long n = vertices.size() - 1;
+        int max_degree = 0;
+        for (long long v = 0; v < n; v++)
+            max_degree = std::max(max_degree, static_cast<int>(vertices[v + 1] - vertices[v]));
+        clique.assign(max_degree + 1, 0);
+        return max_clique_csr(n, vertices.data(), 8, edges.data(), 4, 0,
+                clique.size(), clique.data());
+    }
+
+    PyObject* py_max_clique(PyObject*, PyObject* args, PyObject* kwargs) {
+        static const char* keywords[] = {"ei", "ej", "n", "offset", "threads", NULL};
+        PyObject *ei_obj, *ej_obj;
+        long long n = 0;
+        int offset = 0, threads = 0;
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|Lii", const_cast<char**>(keywords),
+                    &ei_obj, &ej_obj, &n, &offset, &threads))
+            return NULL;
+
+        int_buffer ei, ej;
+        if (!ei.get(ei_obj, "ei") || !ej.get(ej_obj, "ej"))  return NULL;
+        if (ei.size() != ej.size()) {
+            PyErr_SetString(PyExc_ValueError, "ei and ej must have the same length");
+            return NULL;
+        }
+
+        const long long m = ei.size();
+        long long bad = 0;
+        vector<int> clique;
+        int size = 0;
+
+        Py_BEGIN_ALLOW_THREADS
+        if (threads > 0)  omp_set_num_threads(threads);
+
+        // drops nothing but out of range ids, graph_builder mirrors and deduplicates
+        graph_builder builder(static_cast<int>(n));
+        #pragma omp parallel reduction(+:bad)
+        {
+            edge_buffer& buf = builder.get_buffer();
+            #pragma omp for schedule(static)
+            for (long long i = 0; i < m; i++) {
+                const long long v = ei[i] - offset, u = ej[i] - offset;
+                if (v < 0 || u < 0 || v >= INT32_MAX || u >= INT32_MAX)  bad++;
+                else buf.add_edge(static_cast<int>(v), static_cast<int>(u));
+            }
+        }
+        if (bad == 0) {
+            vector<long long> vertices;
+            vector<int> edges;
+            builder.finalize(vertices, edges);
+            size = search_csr(vertices, edges, clique);
+            for (int i = 0; i < size; i++)  clique[i] += offset;
+        }
+        Py_END_ALLOW_THREADS
+
+        if (bad > 0) {
+            PyErr_SetString(PyExc_ValueError, "vertex id out of range");
+            return NULL;
+        }
+        return clique_list(clique, size);
+    }
+
+    PyObject* py_max_clique_csr(PyObject*, PyObject* args, PyObject* kwargs) {
+        static const char* keywords[] = {"indptr", "indices", "offset", "threads", NULL};
+        PyObject *indptr_obj, *indices_obj;
+        int offset = 0, threads = 0;
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|ii", const_cast<char**>(keywords),
+                    &indptr_obj, &indices_obj, &offset, &threads))
+            return NULL;
+
+        int_buffer indptr, indices;
+        if (!indptr.get(indptr_obj, "indptr") || !indices.get(indices_obj, "indices"))  return NULL;
+        const long long n = indptr.size() - 1;
+        if (n < 0 || indptr[n] - offset > indices.size()) {
+            PyErr_SetString(PyExc_ValueError, "indptr does not match indices");
+            return NULL;
+        }
+
+        vector<int> clique;
+        int size = 0;
+
+        Py_BEGIN_ALLOW_THREADS
+        if (threads > 0)  omp_set_num_threads(threads);
+        long long max_degree = 0;
+        for (long long v = 0; v < n; v++)
+            max_degree = std::max(max_degree, indptr[v + 1] - indptr[v]);
+        clique.assign(max_degree + 1, 0);
+        size = max_clique_csr(n, indptr.data(), indptr.width(), indices.data(), indices.width(),
+                offset, clique.size(), clique.data());
+        Py_END_ALLOW_THREADS
+
+        return clique_list(clique, size);
+    }
+
+    PyMethodDef methods[] = {
+        {"max_clique", (PyCFunction)(void(*)(void))py_max_clique, METH_VARARGS | METH_KEYWORDS,
+            "max_clique(ei, ej, n=0, offset=0, threads=0)\n\n"
+            "Maximum clique of the undirected graph with edges (ei[k], ej[k]), ids start at offset."},
+        {"max_clique_csr", (PyCFunction)(void(*)(void))py_max_clique_csr, METH_VARARGS | METH_KEYWORDS,
+            "max_clique_csr(indptr, indices, offset=0, threads=0)\n\n"
+            "Maximum clique of a symmetric sparse matrix in CSR or CSC layout."},
+        {NULL, NULL, 0, NULL}
+    };
+
+    PyModuleDef module = {
+        PyModuleDef_HEAD_INIT, "_pmc", "Parallel maximum clique (PMC) library", -1, methods
+    };
+}
+
+PyMODINIT_FUNC PyInit__pmc(void) {
+    return PyModule_Create(&module);
+}
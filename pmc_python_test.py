@@ -0,0 +1,89 @@
+# pmc.py on numpy arrays of 32 and 64-bit ids, through the _pmc extension and
+# through the ctypes fallback on libpmc, and _pmc on 1-based CSRs.
+# Exits with 77 (skipped under ctest) when numpy is not installed.
+
+import sys
+import unittest
+
+try:
+    import numpy as np
+except ImportError:
+    print("numpy not found, skipped")
+    sys.exit(77)
+
+import pmc
+
+# K5 on {1, 2, 4, 6, 7} plus the edges 0-1, 0-3, 3-4, 5-6
+n = 8
+clique = [1, 2, 4, 6, 7]
+edges = [(0, 1), (0, 3), (3, 4), (5, 6)] + \
+    [(clique[i], clique[j]) for i in range(5) for j in range(i + 1, 5)]
+
+
+class csr_matrix(object):
+    """The indptr/indices of a symmetric scipy.sparse matrix, without scipy."""
+
+    def __init__(self, ptr_type, ind_type, base=0):
+        neigh = [[] for _ in range(n)]
+        for v, u in edges:
+            neigh[v].append(u)
+            neigh[u].append(v)
+        self.indptr = np.cumsum([0] + [len(l) for l in neigh]).astype(ptr_type) + base
+        self.indices = np.array([u for l in neigh for u in sorted(l)], dtype=ind_type) + base
+
+
+class pmc_test(unittest.TestCase):
+
+    def check(self, C, base=0):
+        self.assertEqual(sorted(int(v) for v in C), [v + base for v in clique])
+
+    def edge_list(self, dtype, both_directions):
+        E = edges + [(u, v) for v, u in edges] if both_directions else edges
+        return np.array([e[0] for e in E], dtype=dtype), np.array([e[1] for e in E], dtype=dtype)
+
+    def run_both_paths(self, f):
+        # the extension when it is built, then the ctypes fallback
+        native = pmc._pmc
+        try:
+            if native is not None:
+                f()
+            pmc._pmc = None
+            f()
+        finally:
+            pmc._pmc = native
+
+    def test_edges(self):
+        def f():
+            for dtype in (np.int32, np.int64):
+                for both in (False, True):
+                    ei, ej = self.edge_list(dtype, both)
+                    self.check(pmc.pmc(ei, ej, n, len(ei)))
+        self.run_both_paths(f)
+
+    def test_csr(self):
+        def f():
+            for ptr_type in (np.int32, np.int64):
+                for ind_type in (np.int32, np.int64):
+                    self.check(pmc.pmc_csr(csr_matrix(ptr_type, ind_type)))
+        self.run_both_paths(f)
+
+    @unittest.skipIf(pmc._pmc is None, "_pmc extension not built")
+    def test_one_based(self):
+        for dtype in (np.int32, np.int64):
+            A = csr_matrix(dtype, dtype, 1)
+            self.check(pmc._pmc.max_clique_csr(A.indptr, A.indices, 1), 1)
+            ei, ej = self.edge_list(dtype, False)
+            self.check(pmc._pmc.max_clique(ei + 1, ej + 1, n, 1), 1)
+
+    @unittest.skipIf(pmc._pmc is None, "_pmc extension not built")
+    def test_bad_ids(self):
+        ei, ej = self.edge_list(np.int64, False)
+        with self.assertRaises(ValueError):
+            pmc._pmc.max_clique(ei - 1, ej, n, 0)
+        A = csr_matrix(np.int64, np.int32)
+        with self.assertRaises(ValueError):
+            pmc._pmc.max_clique_csr(A.indptr, A.indices[:-1], 0)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,128 @@
+#include "pmc/pmc.h"
+#include "pmc/pmc_stream.h"
+
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// The fixtures in data/ hold one graph as .mtx, .edges and .gr, plain and
+// gzipped. Every reader must give the same canonical CSR, the two-pass load
+// with a lower bound must keep exactly the (lb-1)-core, and the compressed
+// search must find the same clique size as the plain one.
+
+namespace {
+
+const int omega = 6;
+string dir;
+
+void fail(const char* what, const string& file) {
+    fprintf(stderr, "Test failed: %s, %s\n", what, file.c_str());
+    exit(-1);
+}
+
+// the fixtures this build can read, .gz only when zlib was found
+vector<string> fixtures(bool mtx_and_edges_only) {
+    vector<string> files;
+    for (const char* ext : { "mtx", "edges", "gr" }) {
+        if (mtx_and_edges_only && string(ext) == "gr")  continue;
+        const string file = dir + "/readers_test." + ext;
+        files.push_back(file);
+        if (line_reader::can_decompress(file + ".gz"))  files.push_back(file + ".gz");
+    }
+    return files;
+}
+
+int max_clique_size(pmc_graph& G, bool compressed) {
+    input in;
+    in.threads = 4;
+    in.compressed = compressed;
+    G.compute_cores();
+    in.ub = G.get_max_core() + 1;
+    vector<int> C;
+    pmcx_maxclique finder(G, in);
+    finder.search(G, C);
+    return C.size();
+}
+
+}
+
+void test_same_csr() {
+    pmc_graph R(dir + "/readers_test.mtx");
+    if (!R.is_loaded())  fail("not loaded", dir + "/readers_test.mtx");
+    for (const string& file : fixtures(false)) {
+        pmc_graph G(file);
+        if (!G.is_loaded())  fail("not loaded", file);
+        if (G.get_vertices_array() != R.get_vertices_array() || G.get_edges_array() != R.get_edges_array())
+            fail("CSR differs from the .mtx", file);
+    }
+}
+
+void test_two_pass() {
+    pmc_graph R(dir + "/readers_test.mtx");
+    R.compute_cores();
+    const vector<int>& K = *R.get_kcores();
+    const vector<long long> V = R.get_vertices_array();
+    const vector<int> N = R.get_edges_array();
+    const int n = R.num_vertices();
+
+    for (int lb = 3; lb <= omega + 1; lb++) {
+        // the edges of the full graph between vertices of core number >= lb-1
+        vector<long long> EV(1, 0);
+        vector<int> EN;
+        for (int v = 0; v < n; v++) {
+            if (K[v] - 1 >= lb - 1) {
+                for (long long j = V[v]; j < V[v + 1]; j++)
+                    if (K[N[j]] - 1 >= lb - 1)  EN.push_back(N[j]);
+            }
+            EV.push_back(EN.size());
+        }
+        for (const string& file : fixtures(true)) {
+            pmc_graph G(false, file, lb);
+            if (!G.is_loaded())  fail("not loaded", file);
+            if (G.get_vertices_array() != EV || G.get_edges_array() != EN)
+                fail("two-pass load is not the (lb-1)-core", file);
+        }
+    }
+}
+
+void test_compressed_search() {
+    for (const string& file : fixtures(false)) {
+        pmc_graph G(file), H(file);
+        if (max_clique_size(G, false) != omega || max_clique_size(H, true) != omega)
+            fail("clique size", file);
+    }
+
+    // sparse random graphs with a planted clique
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        mt19937 rng(seed);
+        const int n = 500;
+        vector< vector<int> > L(n);
+        auto add = [&](int v, int u) { L[v].push_back(u);  L[u].push_back(v); };
+        for (int v = 0; v < n; v++)
+            for (int u = v + 1; u < n; u++)
+                if (rng() % 40 == 0)  add(v, u);
+        for (int i = 0; i < 10; i++)
+            for (int j = i + 1; j < 10; j++)  add(i * 37 % n, j * 37 % n);
+
+        vector<long long> vs(1, 0);
+        vector<int> es;
+        for (const vector<int>& l : L) {
+            es.insert(es.end(), l.begin(), l.end());
+            vs.push_back(es.size());
+        }
+        pmc_graph G(vs, es), H(vs, es);
+        if (max_clique_size(G, false) != max_clique_size(H, true))  fail("clique size", "random graph");
+    }
+}
+
+int main(int argc, char **argv) {
+    dir = argc > 1 ? argv[1] : "data";
+    test_same_csr();
+    test_two_pass();
+    test_compressed_search();
+}
@@ -0,0 +1,170 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_builder.h"
+#include "pmc/pmc_debug_utils.h"
+#include "pmc/pmc_graph.h"
+#include "pmc/pmc_utils.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <omp.h>
+
+using namespace pmc;
+using namespace std;
+
+namespace {
+    // reverse Cuthill-McKee: breadth-first from a vertex of least degree in each
+    // component, neighbors visited by increasing degree, then reversed
+    vector<int> rcm_order(const csr_array<long long>& vs, const csr_array<int>& es, const vector<int>& degree) {
+        const int n = vs.size() - 1;
+        vector<int> by_degree(n);
+        std::iota(by_degree.begin(), by_degree.end(), 0);
+        std::stable_sort(by_degree.begin(), by_degree.end(),
+                [&degree](int a, int b) { return degree[a] < degree[b]; });
+
+        vector<int> order;
+        order.reserve(n);
+        vector<char> visited(n, 0);
+        vector<int> next;
+        for (int s : by_degree) {
+            if (visited[s])  continue;
+            visited[s] = 1;
+            order.push_back(s);
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                const int v = order[head];
+                next.clear();
+                for (long long j = vs[v]; j < vs[v + 1]; j++) {
+                    if (!visited[es[j]]) {
+                        visited[es[j]] = 1;
+                        next.push_back(es[j]);
+                    }
+                }
+                std::stable_sort(next.begin(), next.end(),
+                        [&degree](int a, int b) { return degree[a] < degree[b]; });
+                order.insert(order.end(), next.begin(), next.end());
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+}
+
+bool pmc_graph::relabel(const string& ordering) {
+    const int n = num_vertices();
+    if (n <= 0)  return true;
+    if (!has_cores())  compute_cores();
+
+    // order[k] is the vertex that becomes k
+    vector<int> order;
+    if (ordering == "kcore")
+        order.assign(kcore_order.begin(), kcore_order.begin() + n);
+    else if (ordering == "rcm")
+        order = rcm_order(vertices, edges, degree);
+    else {
+        cout << "relabel ordering " << ordering << " not found." <<endl;
+        return false;
+    }
+
+    double sec = get_time();
+    permute(order);
+    DEBUG_PRINTF("[pmc: relabel]  %s order took %.3f sec\n", ordering.c_str(), get_time() - sec);
+    return true;
+}
+
+int pmc_graph::compact(int lb) {
+    const int n = num_vertices();
+    if (n <= 0)  return n;
+    if (!has_cores())  compute_cores();
+
+    // kcore_order is by increasing core, the survivors are a suffix of it
+    int first = 0;
+    while (first < n && kcore[kcore_order[first]] <= lb)  first++;
+    if (first == 0)  return n;
+
+    double sec = get_time();
+    vector<int> order(kcore_order.begin() + first, kcore_order.begin() + n);
+    std::sort(order.begin(), order.end());
+    permute(order);
+    DEBUG_PRINTF("[pmc: compact]  kept %i of %i vertices in %.3f sec\n", num_vertices(), n, get_time() - sec);
+    return num_vertices();
+}
+
+/**
+ * Renames order[k] to k and drops the vertices missing from order
+ *   + neighbor lists are rewritten and sorted in the new ids
+ *   + the k-cores move with their vertex, kcore_order keeps its order
+ *   + labels compose, so original_ids() maps back to the ids of the input
+ */
+void pmc_graph::permute(const vector<int>& order) {
+    const int n = num_vertices();
+    const int m = order.size();
+
+    vector<int> perm(n, -1);
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < m; k++)  perm[order[k]] = k;
+
+    vector<long long> V(m + 1, 0);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (int k = 0; k < m; k++) {
+        long long d = 0;
+        for (long long j = vertices[order[k]]; j < vertices[order[k] + 1]; j++)
+            if (perm[edges[j]] >= 0)  d++;
+        V[k + 1] = d;
+    }
+    prefix_sum(V);
+
+    vector<int> E(V[m]);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (int k = 0; k < m; k++) {
+        long long pos = V[k];
+        for (long long j = vertices[order[k]]; j < vertices[order[k] + 1]; j++)
+            if (perm[edges[j]] >= 0)  E[pos++] = perm[edges[j]];
+        std::sort(E.begin() + V[k], E.begin() + V[k + 1]);
+    }
+
+    vector<int> K(m + 1, 0), K_order(m + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < m; k++)  K[k] = kcore[order[k]];
+    int next = 0;
+    for (int k = 0; k < n; k++)
+        if (perm[kcore_order[k]] >= 0)  K_order[next++] = perm[kcore_order[k]];
+
+    // relabeling twice composes with the earlier labels
+    vector<int> L(m);
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < m; k++)  L[k] = labels.empty() ? order[k] : labels[order[k]];
+
+    vertices = std::move(V);
+    edges = std::move(E);
+    kcore = std::move(K);
+    kcore_order = std::move(K_order);
+    labels = std::move(L);
+    compressed.reset();
+    dynamic_cores.reset();
+    vertex_degrees();
+}
+
+vector<int> pmc_graph::original_ids(const vector<int>& C) const {
+    if (labels.empty())  return C;
+    vector<int> ids(C.size());
+    for (size_t i = 0; i < C.size(); i++)  ids[i] = labels[C[i]];
+    return ids;
+}
@@ -0,0 +1,127 @@
+#include "pmc/pmc.h"
+
+#include <random>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// relabel() followed by compact(), as in pmc_driver: the CSR must be the
+// input graph (restricted to the kept vertices) under the permutation given
+// by original_ids(), and a clique found in the new ids must map back to a
+// clique of the input.
+
+namespace {
+
+typedef set< pair<int,int> > edge_set;
+
+void fail(const char* what, const char* ordering, unsigned seed) {
+    fprintf(stderr, "Test failed: %s, %s, graph %u\n", what, ordering, seed);
+    exit(-1);
+}
+
+pmc_graph make_graph(int n, const edge_set& E) {
+    vector< vector<int> > N(n);
+    for (const auto& e : E) {
+        N[e.first].push_back(e.second);
+        N[e.second].push_back(e.first);
+    }
+    vector<long long> vs(1, 0);
+    vector<int> es;
+    for (const vector<int>& l : N) {
+        es.insert(es.end(), l.begin(), l.end());
+        vs.push_back(es.size());
+    }
+    return pmc_graph(std::move(vs), std::move(es));
+}
+
+// n vertices, edges with probability 1/sparsity, plus a clique on omega
+// vertices spread over the ids
+edge_set random_edges(unsigned seed, int n, int sparsity, int omega) {
+    mt19937 rng(seed);
+    edge_set E;
+    for (int v = 0; v < n; v++)
+        for (int u = v + 1; u < n; u++)
+            if (rng() % sparsity == 0)  E.insert({v, u});
+    for (int i = 0; i < omega; i++)
+        for (int j = i + 1; j < omega; j++)  E.insert({i * 31 % n, j * 31 % n});
+    return E;
+}
+
+void check(const char* ordering, unsigned seed, int n, const edge_set& E, int omega, int lb) {
+    pmc_graph R = make_graph(n, E);
+    R.compute_cores();
+    const vector<int> K = *R.get_kcores();
+
+    pmc_graph G = make_graph(n, E);
+    G.compute_cores();
+    if (!G.relabel(ordering))  fail("relabel", ordering, seed);
+    G.compact(lb);
+    const int m = G.num_vertices();
+
+    // original_ids() is one to one onto the vertices of core bound > lb
+    vector<int> ids(m);
+    for (int v = 0; v < m; v++)  ids[v] = v;
+    const vector<int> orig = G.original_ids(ids);
+    vector<char> seen(n, 0);
+    int kept = 0;
+    for (int v = 0; v < n; v++)  kept += K[v] > lb;
+    if (m != kept)  fail("kept vertices", ordering, seed);
+    for (int v = 0; v < m; v++) {
+        const int o = orig[v];
+        if (o < 0 || o >= n || seen[o] || K[o] <= lb)  fail("original_ids", ordering, seed);
+        seen[o] = 1;
+        if ((*G.get_kcores())[v] != K[o])  fail("k-cores did not move with their vertex", ordering, seed);
+    }
+
+    // the same edges under the permutation, in canonical lists
+    const vector<long long> V = G.get_vertices_array();
+    const vector<int> N = G.get_edges_array();
+    if (!is_canonical_csr(span<const long long>(V.data(), V.size()), span<const int>(N.data(), N.size())))
+        fail("CSR is not canonical", ordering, seed);
+    long long expected = 0;
+    for (const auto& e : E)  expected += K[e.first] > lb && K[e.second] > lb;
+    if ((long long)N.size() != 2 * expected)  fail("number of edges", ordering, seed);
+    for (int v = 0; v < m; v++) {
+        for (long long j = V[v]; j < V[v + 1]; j++) {
+            const int a = orig[v], b = orig[N[j]];
+            if (!E.count({min(a, b), max(a, b)}))  fail("edge not in the input", ordering, seed);
+        }
+    }
+
+    // a maximum clique in the new ids is a clique of the input
+    input in;
+    in.threads = 2;
+    in.lb = lb;
+    in.ub = G.get_max_core() + 1;
+    vector<int> C;
+    pmcx_maxclique finder(G, in);
+    finder.search(G, C);
+    C = G.original_ids(C);
+    if ((int)C.size() != omega)  fail("clique size", ordering, seed);
+    for (int a : C)
+        for (int b : C)
+            if (a != b && !E.count({min(a, b), max(a, b)}))  fail("clique maps back to a non-clique", ordering, seed);
+}
+
+}
+
+void test_relabel_compact() {
+    for (const char* ordering : { "kcore", "rcm" }) {
+        for (unsigned seed = 1; seed <= 4; seed++) {
+            const int n = 300, omega = 9;
+            const edge_set E = random_edges(seed, n, 25, omega);
+            // relabel alone, then with a lower bound that drops most vertices
+            check(ordering, seed, n, E, omega, 0);
+            check(ordering, seed, n, E, omega, 6);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    test_relabel_compact();
+}
@@ -0,0 +1,164 @@
+#include "pmc/pmc.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// The searches intersect neighbor lists as sorted sets. Graphs handed to the
+// constructors with unsorted lists must still be searched correctly.
+
+namespace {
+
+const int n = 200;
+const int omega = 8;
+
+void fail(const char* what) {
+    fprintf(stderr, "Test failed: %s\n", what);
+    exit(-1);
+}
+
+// sparse random graph plus a planted clique on omega vertices, each
+// neighbor list shuffled
+vector< vector<int> > shuffled_lists() {
+    mt19937 rng(7);
+    vector< vector<char> > A(n, vector<char>(n, 0));
+    for (int v = 0; v < n; v++)
+        for (int u = v + 1; u < n; u++)
+            if (rng() % 20 == 0)  A[v][u] = A[u][v] = 1;
+    for (int v = 0; v < omega; v++)
+        for (int u = 0; u < omega; u++)
+            if (u != v)  A[v * 17 % n][u * 17 % n] = 1;
+
+    vector< vector<int> > N(n);
+    for (int v = 0; v < n; v++) {
+        for (int u = 0; u < n; u++)
+            if (A[v][u])  N[v].push_back(u);
+        shuffle(N[v].begin(), N[v].end(), rng);
+    }
+    return N;
+}
+
+pmc_graph vector_graph(const vector< vector<int> >& N) {
+    vector<long long> vs(1, 0);
+    vector<int> es;
+    for (const vector<int>& l : N) {
+        es.insert(es.end(), l.begin(), l.end());
+        vs.push_back(es.size());
+    }
+    return pmc_graph(std::move(vs), std::move(es));
+}
+
+void check_clique(const vector< vector<int> >& N, const vector<int>& C, size_t size, const char* what) {
+    if (C.size() != size)  fail(what);
+    for (int v : C)
+        for (int u : C)
+            if (u != v && find(N[v].begin(), N[v].end(), u) == N[v].end())  fail(what);
+}
+
+// runs algorithm alg (as pmc_driver -a) without a lower bound, so the whole search is done
+vector<int> exact(const vector< vector<int> >& N, int alg, bool dense, int bitset_limit) {
+    pmc_graph G = vector_graph(N);
+    input in;
+    in.threads = 2;
+    in.bitset_limit = bitset_limit;
+    G.compute_cores();
+    in.ub = G.get_max_core() + 1;
+
+    vector<int> C;
+    if (dense)  G.create_adj();
+    if (alg == 0) {
+        pmcx_maxclique finder(G, in);
+        if (dense)  finder.search_dense(G, C);
+        else  finder.search(G, C);
+    }
+    else if (alg == 1) {
+        pmcx_maxclique_basic finder(G, in);
+        if (dense)  finder.search_dense(G, C);
+        else  finder.search(G, C);
+    }
+    else {
+        pmc_maxclique finder(G, in);
+        finder.search(G, C);
+    }
+    return G.original_ids(C);
+}
+
+vector<int> heuristic(pmc_graph& G) {
+    input in;
+    in.threads = 1;
+    G.compute_cores();
+    in.ub = G.get_max_core() + 1;
+    vector<int> C;
+    pmc_heu heu(G, in);
+    heu.search(G, C);
+    return C;
+}
+
+}
+
+void test_unsorted_exact() {
+    vector< vector<int> > N = shuffled_lists();
+    check_clique(N, exact(N, 0, false, 4096), omega, "pmcx_maxclique sparse");
+    check_clique(N, exact(N, 0, false, 0), omega, "pmcx_maxclique sparse, no bit matrix");
+    check_clique(N, exact(N, 0, true, 4096), omega, "pmcx_maxclique dense");
+    check_clique(N, exact(N, 1, false, 4096), omega, "pmcx_maxclique_basic sparse");
+    check_clique(N, exact(N, 1, true, 4096), omega, "pmcx_maxclique_basic dense");
+    check_clique(N, exact(N, 2, false, 4096), omega, "pmc_maxclique");
+}
+
+void test_dense_twice() {
+    // each dense search clears the matrix as it prunes, the next one must not see that
+    vector< vector<int> > N = shuffled_lists();
+    for (int alg = 0; alg <= 2; alg++) {
+        pmc_graph G = vector_graph(N);
+        G.create_adj();
+        for (int run = 0; run < 2; run++) {
+            input in;
+            in.threads = 2;
+            G.compute_cores();
+            in.ub = G.get_max_core() + 1;
+            vector<int> C;
+            if (alg == 0) {
+                pmcx_maxclique finder(G, in);
+                finder.search_dense(G, C);
+            }
+            else if (alg == 1) {
+                pmcx_maxclique_basic finder(G, in);
+                finder.search_dense(G, C);
+            }
+            else {
+                pmc_maxclique finder(G, in);
+                finder.search_dense(G, C);
+            }
+            check_clique(N, C, omega, "second dense search on the same graph");
+        }
+    }
+}
+
+void test_unsorted_heuristic() {
+    vector< vector<int> > N = shuffled_lists();
+    vector< vector<int> > S = N;
+    for (vector<int>& l : S)  sort(l.begin(), l.end());
+
+    pmc_graph G = vector_graph(N), H = vector_graph(S);
+    vector<int> C = heuristic(G);
+    check_clique(N, C, heuristic(H).size(), "pmc_heu");
+
+    // the map constructor as well
+    map<int, vector<int>> v_map;
+    for (int v = 0; v < n; v++)  v_map[v] = N[v];
+    pmc_graph M(v_map);
+    check_clique(N, heuristic(M), C.size(), "pmc_heu, map constructor");
+}
+
+int main(int argc, char **argv) {
+    test_unsorted_exact();
+    test_dense_twice();
+    test_unsorted_heuristic();
+}
@@ -0,0 +1,327 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_stream.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#ifdef PMC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef PMC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef PMC_HAVE_LZMA
+#include <lzma.h>
+#endif
+
+using namespace pmc;
+using namespace std;
+
+namespace pmc {
+    /// Decompresses a file sequentially.
+    class stream_decoder {
+        public:
+            virtual ~stream_decoder() {}
+            // fills at most n bytes of buf, returns 0 at the end of the input and -1 on errors
+            virtual long read(char* buf, size_t n) = 0;
+    };
+}
+
+namespace {
+    const size_t block_size = 16 << 20;
+    const int num_buffers = 3;
+
+    string suffix(const string& filename) {
+        string::size_type dot = filename.rfind('.');
+        return dot == string::npos ? "" : filename.substr(dot + 1);
+    }
+
+#ifdef PMC_HAVE_ZLIB
+    class gz_decoder : public stream_decoder {
+        private:
+            gzFile f;
+        public:
+            explicit gz_decoder(const string& filename) {
+                f = gzopen(filename.c_str(), "rb");
+                if (f != NULL)  gzbuffer(f, 1 << 20);
+            }
+            ~gz_decoder() { if (f != NULL) gzclose(f); }
+            bool ok() const { return f != NULL; }
+
+            long read(char* buf, size_t n) override {
+                int r = gzread(f, buf, static_cast<unsigned>(n < INT_MAX ? n : INT_MAX));
+                if (r == 0) {
+                    // a truncated stream ends without an error from gzread
+                    int err = Z_OK;
+                    gzerror(f, &err);
+                    if (err != Z_OK)  return -1;
+                }
+                return r;
+            }
+    };
+#endif
+
+#ifdef PMC_HAVE_ZSTD
+    class zstd_decoder : public stream_decoder {
+        private:
+            FILE* f;
+            ZSTD_DStream* ds;
+            vector<char> in;
+            ZSTD_inBuffer input;
+            size_t pending;
+            bool eof;
+            bool failed;
+        public:
+            explicit zstd_decoder(const string& filename)
+                : ds(ZSTD_createDStream()), in(ZSTD_DStreamInSize()), pending(0), eof(false), failed(false) {
+                f = fopen(filename.c_str(), "rb");
+                input.src = in.data();
+                input.size = 0;
+                input.pos = 0;
+                ZSTD_initDStream(ds);
+            }
+            ~zstd_decoder() {
+                if (f != NULL)  fclose(f);
+                ZSTD_freeDStream(ds);
+            }
+            bool ok() const { return f != NULL; }
+
+            long read(char* buf, size_t n) override {
+                ZSTD_outBuffer output = {buf, n, 0};
+                while (output.pos < output.size && !failed) {
+                    if (input.pos == input.size) {
+                        if (eof)  break;
+                        input.size = fread(in.data(), 1, in.size(), f);
+                        input.pos = 0;
+                        if (input.size == 0) {
+                            eof = true;
+                            break;
+                        }
+                    }
+                    size_t ret = ZSTD_decompressStream(ds, &output, &input);
+                    if (ZSTD_isError(ret)) {
+                        failed = true;
+                        break;
+                    }
+                    pending = ret;
+                }
+                // a frame left incomplete at the end of the file is truncated
+                if (eof && pending != 0)  failed = true;
+                if (failed && output.pos == 0)  return -1;
+                return static_cast<long>(output.pos);
+            }
+    };
+#endif
+
+#ifdef PMC_HAVE_LZMA
+    class xz_decoder : public stream_decoder {
+        private:
+            FILE* f;
+            lzma_stream strm;
+            vector<uint8_t> in;
+            bool eof;
+            bool stream_end;
+            bool failed;
+        public:
+            explicit xz_decoder(const string& filename)
+                : in(1 << 20), eof(false), stream_end(false), failed(false) {
+                strm = LZMA_STREAM_INIT;
+                f = fopen(filename.c_str(), "rb");
+                if (f != NULL && lzma_stream_decoder(&strm, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+                    fclose(f);
+                    f = NULL;
+                }
+            }
+            ~xz_decoder() {
+                if (f != NULL)  fclose(f);
+                lzma_end(&strm);
+            }
+            bool ok() const { return f != NULL; }
+
+            long read(char* buf, size_t n) override {
+                strm.next_out = reinterpret_cast<uint8_t*>(buf);
+                strm.avail_out = n;
+                while (strm.avail_out > 0 && !stream_end && !failed) {
+                    if (strm.avail_in == 0 && !eof) {
+                        strm.next_in = in.data();
+                        strm.avail_in = fread(in.data(), 1, in.size(), f);
+                        if (strm.avail_in == 0)  eof = true;
+                    }
+                    lzma_ret ret = lzma_code(&strm, eof ? LZMA_FINISH : LZMA_RUN);
+                    if (ret == LZMA_STREAM_END)  stream_end = true;
+                    else if (ret != LZMA_OK) {
+                        // hand out what was decoded, the next call reports the error
+                        failed = true;
+                        break;
+                    }
+                }
+                if (failed && strm.avail_out == n)  return -1;
+                return static_cast<long>(n - strm.avail_out);
+            }
+    };
+#endif
+
+    template <class Decoder>
+    unique_ptr<stream_decoder> open_decoder(const string& filename) {
+        unique_ptr<Decoder> d(new Decoder(filename));
+        if (!d->ok())  return nullptr;
+        return unique_ptr<stream_decoder>(std::move(d));
+    }
+
+    unique_ptr<stream_decoder> make_decoder(const string& filename) {
+        const string ext = suffix(filename);
+#ifdef PMC_HAVE_ZLIB
+        if (ext == "gz")  return open_decoder<gz_decoder>(filename);
+#endif
+#ifdef PMC_HAVE_ZSTD
+        if (ext == "zst")  return open_decoder<zstd_decoder>(filename);
+#endif
+#ifdef PMC_HAVE_LZMA
+        if (ext == "xz")  return open_decoder<xz_decoder>(filename);
+#endif
+        return nullptr;
+    }
+}
+
+line_reader::line_reader(const string& filename)
+    : mapped_done(false), finished(false), cancelled(false), failed(false), total(0) {
+
+    if (!is_compressed(filename)) {
+        if (file.open(filename))  total = file.size();
+        return;
+    }
+
+    decoder = make_decoder(filename);
+    if (decoder == nullptr)  return;
+    free.resize(num_buffers);
+    worker = std::thread(&line_reader::decompress, this);
+}
+
+line_reader::~line_reader() {
+    if (worker.joinable()) {
+        {
+            lock_guard<mutex> lk(lock);
+            cancelled = true;
+        }
+        cond.notify_all();
+        worker.join();
+    }
+}
+
+void line_reader::decompress() {
+    vector<char> carry;
+    bool eof = false;
+
+    while (!eof) {
+        vector<char> buf;
+        {
+            unique_lock<mutex> lk(lock);
+            cond.wait(lk, [this] { return cancelled || !free.empty(); });
+            if (cancelled)  return;
+            buf = std::move(free.back());
+            free.pop_back();
+        }
+
+        // the partial last line of the previous block starts this one
+        size_t len = carry.size();
+        buf.resize(len + block_size);
+        if (len > 0)  memcpy(buf.data(), carry.data(), len);
+
+        while (len < buf.size()) {
+            long r = decoder->read(buf.data() + len, buf.size() - len);
+            if (r <= 0) {
+                if (r < 0)  failed = true;
+                eof = true;
+                break;
+            }
+            len += r;
+        }
+
+        size_t cut = len;
+        if (!eof)
+            while (cut > 0 && buf[cut - 1] != '\n')  cut--;
+        carry.assign(buf.begin() + cut, buf.begin() + len);
+        buf.resize(cut);
+
+        {
+            lock_guard<mutex> lk(lock);
+            full.push_back(std::move(buf));
+        }
+        cond.notify_all();
+    }
+
+    {
+        lock_guard<mutex> lk(lock);
+        finished = true;
+    }
+    cond.notify_all();
+}
+
+bool line_reader::next(const char*& begin, const char*& end) {
+    if (decoder == nullptr) {
+        if (!file.is_open() || mapped_done)  return false;
+        mapped_done = true;
+        begin = file.data();
+        end = file.end();
+        return true;
+    }
+
+    unique_lock<mutex> lk(lock);
+    if (current.capacity() > 0) {
+        free.push_back(std::move(current));
+        current = vector<char>();
+        cond.notify_all();
+    }
+    cond.wait(lk, [this] { return !full.empty() || finished; });
+    if (full.empty())  return false;
+
+    current = std::move(full.front());
+    full.pop_front();
+    total += current.size();
+    begin = current.data();
+    end = begin + current.size();
+    return true;
+}
+
+bool line_reader::is_compressed(const string& filename) {
+    const string ext = suffix(filename);
+    return ext == "gz" || ext == "zst" || ext == "xz";
+}
+
+bool line_reader::can_decompress(const string& filename) {
+    const string ext = suffix(filename);
+#ifdef PMC_HAVE_ZLIB
+    if (ext == "gz")  return true;
+#endif
+#ifdef PMC_HAVE_ZSTD
+    if (ext == "zst")  return true;
+#endif
+#ifdef PMC_HAVE_LZMA
+    if (ext == "xz")  return true;
+#endif
+    return false;
+}
+
+string line_reader::strip_compression(const string& filename) {
+    if (!is_compressed(filename))  return filename;
+    return filename.substr(0, filename.rfind('.'));
+}
@@ -0,0 +1,270 @@
+/**
+ ============================================================================
+ Name        : Parallel Maximum Clique (PMC) Library
+ Author      : Ryan A. Rossi   (rrossi@purdue.edu)
+ Description : A general high-performance parallel framework for computing
+               maximum cliques. The library is designed to be fast for large
+               sparse graphs.
+
+ Copyright (C) 2012-2013, Ryan A. Rossi, All rights reserved.
+
+ Please cite the following paper if used:
+   Ryan A. Rossi, David F. Gleich, Assefaw H. Gebremedhin, Md. Mostofa
+   Patwary, A Fast Parallel Maximum Clique Algorithm for Large Sparse Graphs
+   and Temporal Strong Components, arXiv preprint 1302.6256, 2013.
+
+ See http://ryanrossi.com/pmc for more information.
+ ============================================================================
+ */
+
+#include "pmc/pmc_builder.h"
+#include "pmc/pmc_debug_utils.h"
+#include "pmc/pmc_graph.h"
+#include "pmc/pmc_utils.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <omp.h>
+
+using namespace pmc;
+using namespace std;
+
+namespace {
+
+    // decrements the support of edge e, never below the current level k
+    inline void decrement_support(vector<int>& sup, long long e, int k, vector<long long>& next) {
+        if (sup[e] <= k)  return;
+        int s;
+        #pragma omp atomic capture
+        s = sup[e]--;
+        if (s == k + 1)  next.push_back(e);
+        else if (s <= k) {
+            #pragma omp atomic
+            sup[e]++;
+        }
+    }
+
+}
+
+/**
+ * Truss decomposition by parallel edge peeling (PKT)
+ *   + support: triangles are listed once over the edges oriented from lower to
+ *     higher (degree, id), each adds one to the support of its three edges
+ *   + peeling: level k removes every edge of support <= k together with the edges
+ *     that drop to k, atomically decrementing the other two edges of each triangle.
+ *     A triangle with two edges removed in the same round is counted by the smaller one.
+ *   + each undirected edge is kept on the slot from its smaller endpoint, then
+ *     copied to the other direction
+ */
+int pmc_graph::compute_truss(vector<int>& truss) const {
+    const int n = num_vertices();
+    const long long m2 = edges.size();
+    truss.assign(m2, 2);
+    if (m2 == 0)  return n > 0 ? 1 : 0;
+
+    double sec = get_time();
+    auto deg = [&](int v) { return vertices[v + 1] - vertices[v]; };
+    auto higher = [&](int u, int v) { return deg(u) < deg(v) || (deg(u) == deg(v) && u < v); };
+
+    // slot of the reverse direction of each edge
+    vector<long long> rev(m2);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int u = 0; u < n; u++) {
+        for (long long j = vertices[u]; j < vertices[u + 1]; j++) {
+            const int v = edges[j];
+            rev[j] = lower_bound(edges.data() + vertices[v], edges.data() + vertices[v + 1], u) - edges.data();
+        }
+    }
+    auto canon = [&](int u, long long j) { return u < edges[j] ? j : rev[j]; };
+
+    // edges oriented towards the higher vertex, with their slot in the CSR
+    vector<long long> fo(n + 1, 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int u = 0; u < n; u++) {
+        long long c = 0;
+        for (long long j = vertices[u]; j < vertices[u + 1]; j++)
+            if (higher(u, edges[j]))  c++;
+        fo[u + 1] = c;
+    }
+    prefix_sum(fo);
+    vector<int> fe(fo[n]);
+    vector<long long> fslot(fo[n]);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int u = 0; u < n; u++) {
+        long long pos = fo[u];
+        for (long long j = vertices[u]; j < vertices[u + 1]; j++) {
+            if (higher(u, edges[j])) {
+                fe[pos] = edges[j];
+                fslot[pos++] = j;
+            }
+        }
+    }
+
+    vector<int> sup(m2, 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int u = 0; u < n; u++) {
+        for (long long x = fo[u]; x < fo[u + 1]; x++) {
+            const int v = fe[x];
+            long long p = fo[u], q = fo[v];
+            while (p < fo[u + 1] && q < fo[v + 1]) {
+                if (fe[p] < fe[q])  p++;
+                else if (fe[p] > fe[q])  q++;
+                else {
+                    const long long e[3] = { canon(u, fslot[x]), canon(u, fslot[p]), canon(v, fslot[q]) };
+                    for (long long c : e) {
+                        #pragma omp atomic
+                        sup[c]++;
+                    }
+                    p++;  q++;
+                }
+            }
+        }
+    }
+    vector<int>().swap(fe);
+    vector<long long>().swap(fslot);
+    vector<long long>().swap(fo);
+    DEBUG_PRINTF("[pmc: truss]  support took %.3f sec\n", get_time() - sec);
+
+    vector<char> done(m2, 0), curr(m2, 0);
+    long long left = m2 / 2;
+    long long round = 0;
+    int min_sup = 0;
+
+    #pragma omp parallel
+    {
+        vector<long long> buf, next;
+        while (left > 0) {
+            // the next level is the smallest support left
+            #pragma omp single
+            min_sup = INT_MAX;
+            int local_min = INT_MAX;
+            #pragma omp for schedule(dynamic, 64) nowait
+            for (int u = 0; u < n; u++)
+                for (long long j = vertices[u]; j < vertices[u + 1]; j++)
+                    if (u < edges[j] && !done[j] && sup[j] < local_min)  local_min = sup[j];
+            #pragma omp critical (pmc_truss_level)
+            if (local_min < min_sup)  min_sup = local_min;
+            #pragma omp barrier
+            const int k = min_sup;
+
+            buf.clear();
+            #pragma omp for schedule(dynamic, 64)
+            for (int u = 0; u < n; u++) {
+                for (long long j = vertices[u]; j < vertices[u + 1]; j++) {
+                    if (u < edges[j] && !done[j] && sup[j] <= k) {
+                        buf.push_back(j);
+                        curr[j] = 1;
+                    }
+                }
+            }
+
+            while (true) {
+                next.clear();
+                for (long long e : buf) {
+                    const int u = upper_bound(vertices.data(), vertices.data() + n + 1, e) - vertices.data() - 1;
+                    const int v = edges[e];
+                    const int a = deg(u) <= deg(v) ? u : v;
+                    const int b = a == u ? v : u;
+                    const int* Nb = edges.data() + vertices[b];
+                    const int* Nb_end = edges.data() + vertices[b + 1];
+                    for (long long j = vertices[a]; j < vertices[a + 1]; j++) {
+                        const int w = edges[j];
+                        if (w == b)  continue;
+                        const int* it = lower_bound(Nb, Nb_end, w);
+                        if (it == Nb_end || *it != w)  continue;
+                        const long long e1 = canon(a, j);
+                        const long long e2 = canon(b, it - edges.data());
+                        if (done[e1] || done[e2])  continue;
+
+                        if (!curr[e1] && !curr[e2]) {
+                            decrement_support(sup, e1, k, next);
+                            decrement_support(sup, e2, k, next);
+                        }
+                        else if (curr[e1] && !curr[e2]) {
+                            if (e < e1)  decrement_support(sup, e2, k, next);
+                        }
+                        else if (!curr[e1] && curr[e2]) {
+                            if (e < e2)  decrement_support(sup, e1, k, next);
+                        }
+                    }
+                }
+                #pragma omp barrier
+
+                for (long long e : buf) {
+                    done[e] = 1;
+                    curr[e] = 0;
+                    truss[e] = k + 2;
+                }
+                #pragma omp atomic
+                left -= buf.size();
+                #pragma omp single
+                round = 0;
+
+                buf.swap(next);
+                for (long long e : buf)  curr[e] = 1;
+                #pragma omp atomic
+                round += buf.size();
+                #pragma omp barrier
+                if (round == 0)  break;
+            }
+        }
+    }
+
+    int max_truss = 2;
+    #pragma omp parallel for schedule(dynamic, 64) reduction(max:max_truss)
+    for (int u = 0; u < n; u++) {
+        for (long long j = vertices[u]; j < vertices[u + 1]; j++) {
+            if (u < edges[j]) {
+                truss[rev[j]] = truss[j];
+                if (truss[j] > max_truss)  max_truss = truss[j];
+            }
+        }
+    }
+    DEBUG_PRINTF("[pmc: truss]  max truss = %i, took %.3f sec\n", max_truss, get_time() - sec);
+    return max_truss;
+}
+
+
+/**
+ * Removes the edges of truss number < lb
+ *   + every edge of a clique of size k lies in k-2 of its triangles, so the
+ *     cliques of size >= lb keep all their edges
+ *   + the vertices keep their ids, the k-cores are recomputed on what is left
+ */
+int pmc_graph::truss_pruning(int lb) {
+    vector<int> truss;
+    const int max_truss = compute_truss(truss);
+    if (lb < 3)  return max_truss;
+
+    const int n = num_vertices();
+    vector<long long> V(n + 1, 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int u = 0; u < n; u++) {
+        long long c = 0;
+        for (long long j = vertices[u]; j < vertices[u + 1]; j++)
+            if (truss[j] >= lb)  c++;
+        V[u + 1] = c;
+    }
+    prefix_sum(V);
+    if (V[n] == (long long)edges.size())  return max_truss;
+
+    vector<int> E(V[n]);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int u = 0; u < n; u++) {
+        long long pos = V[u];
+        for (long long j = vertices[u]; j < vertices[u + 1]; j++) {
+            if (truss[j] >= lb)  E[pos++] = edges[j];
+            else if (!adj.empty())  adj.reset(u, edges[j]);
+        }
+    }
+
+    cout << "[pmc: truss pruning]  removed " << (edges.size() - V[n]) / 2 << " of "
+        << num_edges() << " edges, max truss = " << max_truss << endl;
+    vertices = std::move(V);
+    edges = std::move(E);
+    compressed.reset();
+    vertex_degrees();
+    compute_cores();
+    return max_truss;
+}
@@ -0,0 +1,192 @@
+#include "pmc/pmc.h"
+
+#include <map>
+#include <omp.h>
+#include <random>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace pmc;
+
+// compute_truss() and truss_pruning() against peeling the triangle supports
+// one edge at a time, and pruning never drops an edge of a maximum clique.
+
+namespace {
+
+typedef set< pair<int,int> > edge_set;
+
+void fail(const char* what, const char* graph) {
+    fprintf(stderr, "Test failed: %s, %s\n", what, graph);
+    exit(-1);
+}
+
+pmc_graph make_graph(int n, const edge_set& E) {
+    vector< vector<int> > N(n);
+    for (const auto& e : E) {
+        N[e.first].push_back(e.second);
+        N[e.second].push_back(e.first);
+    }
+    vector<long long> vs(1, 0);
+    vector<int> es;
+    for (const vector<int>& l : N) {
+        es.insert(es.end(), l.begin(), l.end());
+        vs.push_back(es.size());
+    }
+    return pmc_graph(std::move(vs), std::move(es));
+}
+
+void add_clique(edge_set& E, const vector<int>& S) {
+    for (int v : S)
+        for (int u : S)
+            if (v < u)  E.insert({v, u});
+}
+
+// truss number of each edge: level k removes, one at a time, the edges left
+// in at most k triangles, which gives them truss number k+2
+map< pair<int,int>, int > brute_truss(int n, edge_set E) {
+    map< pair<int,int>, int > truss;
+    for (int k = 0; !E.empty(); k++) {
+        bool removed = true;
+        while (removed) {
+            removed = false;
+            for (auto it = E.begin(); it != E.end(); ) {
+                int sup = 0;
+                for (int w = 0; w < n; w++) {
+                    if (E.count({min(it->first, w), max(it->first, w)}) &&
+                            E.count({min(it->second, w), max(it->second, w)}))
+                        sup++;
+                }
+                if (sup <= k) {
+                    truss[*it] = k + 2;
+                    it = E.erase(it);
+                    removed = true;
+                }
+                else ++it;
+            }
+        }
+    }
+    return truss;
+}
+
+void check_truss(const char* graph, int n, const edge_set& E) {
+    pmc_graph G = make_graph(n, E);
+    vector<int> truss;
+    const int max_truss = G.compute_truss(truss);
+    const map< pair<int,int>, int > expected = brute_truss(n, E);
+
+    const vector<long long> V = G.get_vertices_array();
+    const vector<int> N = G.get_edges_array();
+    int expected_max = 2;
+    for (int v = 0; v < n; v++) {
+        for (long long j = V[v]; j < V[v + 1]; j++) {
+            const int t = expected.at({min(v, N[j]), max(v, N[j])});
+            if (truss[j] != t)  fail("truss number", graph);
+            if (t > expected_max)  expected_max = t;
+        }
+    }
+    if (!E.empty() && max_truss != expected_max)  fail("max truss", graph);
+
+    // pruning at every lower bound keeps exactly the edges of truss >= lb
+    for (int lb = 3; lb <= expected_max + 1; lb++) {
+        pmc_graph H = make_graph(n, E);
+        H.compute_cores();
+        H.truss_pruning(lb);
+        const vector<long long> HV = H.get_vertices_array();
+        const vector<int> HN = H.get_edges_array();
+        edge_set kept;
+        for (int v = 0; v < n; v++)
+            for (long long j = HV[v]; j < HV[v + 1]; j++)
+                kept.insert({min(v, HN[j]), max(v, HN[j])});
+        for (const auto& e : expected)
+            if ((e.second >= lb) != (kept.count(e.first) > 0))  fail("pruned edges", graph);
+        if (kept.size() * 2 != HN.size())  fail("pruned graph is not symmetric", graph);
+    }
+}
+
+// truss_pruning with the size of a known maximum clique as the bound
+void check_clique_kept(const char* graph, int n, const edge_set& E, const vector<int>& C) {
+    pmc_graph G = make_graph(n, E);
+    G.compute_cores();
+    G.truss_pruning(C.size());
+    const vector<long long> V = G.get_vertices_array();
+    const vector<int> N = G.get_edges_array();
+    for (int v : C) {
+        for (int u : C) {
+            if (u == v)  continue;
+            bool found = false;
+            for (long long j = V[v]; j < V[v + 1]; j++)
+                if (N[j] == u)  found = true;
+            if (!found)  fail("clique edge pruned", graph);
+        }
+    }
+}
+
+}
+
+void test_cliques() {
+    for (int n : { 1, 2, 3, 4, 7, 12 }) {
+        edge_set E;
+        vector<int> S;
+        for (int v = 0; v < n; v++)  S.push_back(v);
+        add_clique(E, S);
+        check_truss("K_n", n, E);
+        check_clique_kept("K_n", n, E, S);
+    }
+}
+
+void test_triangle_free() {
+    // a 5x6 grid and the complete bipartite K_{4,5}: every truss number is 2
+    edge_set grid, bip;
+    for (int r = 0; r < 5; r++) {
+        for (int c = 0; c < 6; c++) {
+            if (c + 1 < 6)  grid.insert({6 * r + c, 6 * r + c + 1});
+            if (r + 1 < 5)  grid.insert({6 * r + c, 6 * (r + 1) + c});
+        }
+    }
+    for (int v = 0; v < 4; v++)
+        for (int u = 4; u < 9; u++)  bip.insert({v, u});
+    check_truss("grid", 30, grid);
+    check_truss("K_{4,5}", 9, bip);
+}
+
+void test_bridge() {
+    // K_6 and K_4 joined by the edge 5-6, plus a pendant triangle on the bridge
+    edge_set E;
+    vector<int> A = { 0, 1, 2, 3, 4, 5 }, B = { 6, 7, 8, 9 };
+    add_clique(E, A);
+    add_clique(E, B);
+    E.insert({5, 6});
+    E.insert({5, 10});
+    E.insert({6, 10});
+    check_truss("two cliques and a bridge", 11, E);
+    check_clique_kept("two cliques and a bridge", 11, E, A);
+}
+
+void test_random() {
+    // sparse random graphs with a planted clique that is the largest one
+    for (unsigned seed = 1; seed <= 4; seed++) {
+        mt19937 rng(seed);
+        const int n = 60;
+        edge_set E;
+        for (int v = 0; v < n; v++)
+            for (int u = v + 1; u < n; u++)
+                if (rng() % 12 == 0)  E.insert({v, u});
+        vector<int> C;
+        for (int i = 0; i < 9; i++)  C.push_back(i * 7 % n);
+        add_clique(E, C);
+        check_truss("random", n, E);
+        check_clique_kept("random", n, E, C);
+    }
+}
+
+int main(int argc, char **argv) {
+    omp_set_num_threads(4);
+    test_cliques();
+    test_triangle_free();
+    test_bridge();
+    test_random();
+}
@@ -45,12 +45,19 @@ void usage(char *argv0) {
             "\t-e neigh/edge ordering       : Ordering of neighbors/edges (default = deg, [kcore, dual_deg, dual_kcore, kcore_deg, rand]) \n"
             "\t-h heuristic strategy        : Strategy for HEURISTIC method (default = kcore, [deg, dual_deg, dual_kcore, rand, 0 = skip heuristic]) \n"
             "\t-u upper_bound               : UPPER-BOUND on clique size (default = K-cores).\n"
-            "\t-l lower_bound               : LOWER-BOUND on clique size (default = Estimate using the Fast Heuristic). \n"
+            "\t-l lower_bound               : LOWER-BOUND on clique size (default = Estimate using the Fast Heuristic), also prunes the graph while loading. \n"
             "\t-t threads                   : Number of THREADS for the algorithm to use (default = 1). \n"
             "\t-r reduce_wait               : Number of SECONDS to wait before inducing the graph based on the unpruned vertices (default = 4 seconds). \n"
             "\t-w time_limit                : Execution TIME LIMIT spent searching for max clique (default = 7 days) \n"
             "\t-k clique size               : Solve K-CLIQUE problem: find clique of size k if it exists. Parameterized to be fast. \n"
             "\t-s stats                     : Compute BOUNDS and other fast graph stats \n"
+            "\t-b binary file               : Save the graph and its k-cores as a binary snapshot (.pmcb) for fast loading, not with -l or -k \n"
+            "\t-p relabel ordering          : Relabel vertices for cache locality before the search ([kcore, rcm], default = off) \n"
+            "\t-m k-core method             : Method for computing the K-CORES (default = bz, [pkc = parallel peeling]) \n"
+            "\t-c compressed adjacency      : Search over delta/varint encoded neighbor lists to save memory, slower (-a 0 on sparse graphs) \n"
+            "\t-B bitset limit              : Largest root neighborhood searched over a local bit matrix (default = 4096, 0 = off) \n"
+            "\t-D bitset density            : Least induced density of a neighborhood for the bit matrix search (default = 0.05) \n"
+            "\t-T truss pruning             : Remove the edges in too few triangles for a clique larger than the lower bound, ub = max truss \n"
             "\t-v verbose                   : Output additional details to the screen. \n"
             "\t-? options                   : Print out this help menu. \n";
     fprintf(stderr, params, argv0);
@@ -18,16 +18,35 @@
  */
 
 #include "pmc/pmcx_maxclique.h"
+#include "pmc/pmc_bound_refresh.h"
+#include "pmc/pmc_intersect.h"
 #include "pmc/pmc_neigh_coloring.h"
 #include "pmc/pmc_neigh_cores.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace std;
 using namespace pmc;
 
 int pmcx_maxclique::search(pmc_graph& G, vector<int>& sol) {
+    if (use_compressed)
+        return search_compressed(G, sol);
+    // the offset width is picked from the number of stored edges
+    if (G.fits_narrow_offsets())
+        return search_sparse<uint32_t>(G, sol);
+    return search_sparse<long long>(G, sol);
+}
+
+void pmcx_maxclique::print_root_kernels(const char* fallback) {
+    cout << "[pmc: root neighborhoods]  bit matrix = " << bitset_roots;
+    cout << ", " << fallback << " = " << sparse_roots << endl;
+}
 
+template <class Offset>
+int pmcx_maxclique::search_sparse(pmc_graph& G, vector<int>& sol) {
+
+    degree = G.get_degree();
     bool_vector pruned(G.num_vertices());
     int mc = lb, i = 0, u = 0;
 
@@ -57,43 +76,40 @@ int pmcx_maxclique::search(pmc_graph& G, vector<int>& sol) {
     DEBUG_PRINTF("|V| = %i\n", V.size());
 
     vector<short> ind(G.num_vertices(),0);
-    vector<int> es = G.get_edges_array();
-    vector<long long> vs = G.get_vertices_array();
+    bitset_solver solver(G.num_vertices());
+    // per-thread copies borrow these arrays until a thread reduces its graph
+    csr_array<int> es = G.edges_view();
+    csr_array<Offset> offsets;
+    G.offsets(offsets);
+    csr_array<Offset> vs = offsets.view();
 
     vector<double> induce_time(num_threads,get_time());
     for (int t = 0; t < num_threads; ++t)  induce_time[t] = induce_time[t] + t/4;
 
-    #pragma omp parallel for schedule(dynamic) shared(pruned, G, T, V, mc, C_max, induce_time) \
-        firstprivate(colors,ind,vs,es) private(u, P, C) num_threads(num_threads)
-    for (i = 0; i < (V.size()) - (mc-1); ++i) {
+    // k-cores of the unpruned vertices, refreshed in the background as threads reduce their graphs
+    bound_refresh refresh(G, pruned);
+
+    #pragma omp parallel for schedule(dynamic) shared(pruned, G, T, V, mc, C_max, induce_time, refresh) \
+        firstprivate(colors,ind,solver,vs,es) private(u, P, C) num_threads(num_threads)
+    for (i = 0; i < (long long)V.size() - max(mc-1, 0); ++i) {
         if (not_reached_ub) {
             if (G.time_left(C_max,sec,time_limit,time_expired_msg)) {
 
                 u = V[i].get_id();
+                // bounds for this root, refreshes publish a new array and leave this one intact
+                bound_refresh::snapshot bounds = refresh.acquire();
+                const vector<int>* bound = bounds.get();
                 if ((*bound)[u] > mc) {
-                    P.push_back(V[i]);
-                    for (long long j = vs[u]; j < vs[u + 1]; ++j)
-                        if (!pruned[es[j]])
-                            if ((*bound)[es[j]] > mc)
-                            	P.push_back(Vertex(es[j], (vs[es[j]+1] - vs[es[j]]) )); /// local
-
-
-                    if (P.size() > mc) {
-                        neigh_cores_bound(vs,es,P,ind,mc);
-                        if (P.size() > mc && P[0].get_bound() >= mc) {
-                            neigh_coloring_bound(vs,es,P,ind,C,colors,mc);
-                            if (P.back().get_bound() > mc) {
-                                branch(vs,es,P, ind, C, C_max, colors, pruned, mc);
-                            }
-                        }
-                    }
+                    search_root(basic_csr_adjacency<Offset>(vs, es), V[i], P, ind, C, C_max, colors, solver, pruned, bound, mc);
                     P = T;
                 }
                 pruned[u] = true;
+                refresh.prune(u);
 
                 // dynamically reduce graph in a thread-safe manner
                 if ((get_time() - induce_time[omp_get_thread_num()]) > wait_time) {
                     G.reduce_graph( vs, es, pruned, G);
+                    refresh.request();
                     G.graph_stats(G, mc, i+lb_idx, sec);
                     induce_time[omp_get_thread_num()] = get_time();
                 }
@@ -101,21 +117,117 @@ int pmcx_maxclique::search(pmc_graph& G, vector<int>& sol) {
         }
     }
 
+    refresh.stop();
     sol.resize(mc);
     for (int i = 0; i < C_max.size(); i++)  sol[i] = C_max[i];
+    print_root_kernels("neighbor lists");
     G.print_break();
     return sol.size();
 }
 
+void pmcx_maxclique::record_clique(const vector<int>& C, vector<int>& C_max, int& mc) {
+    // obtain lock
+    #pragma omp critical (update_mc)
+    if (C.size() > mc) {
+        mc = C.size();
+        C_max = C;
+        print_mc_info(C_max,sec);
+        if (mc >= param_ub) {
+            not_reached_ub = false;
+            DEBUG_PRINTF("[pmc: upper bound reached]  omega = %i\n", mc);
+        }
+    }
+}
+
+/**
+ * Kernel for the neighborhood of a root
+ *   + the bit matrix costs |P|^2/64 words to build and scan, the neighbor
+ *     lists the edges of P, so it pays off for |P| <= 64 or dense P
+ *   + the induced edges are counted with one scatter over ind
+ */
+template <class Adjacency>
+bool pmcx_maxclique::use_bitset(
+        const Adjacency& A,
+        const vector<Vertex> &P,
+        vector<short>& ind) {
+
+    bool bitset = false;
+    const long long p = P.size();
+    if (p <= bitset_limit && p <= 64)  bitset = true;
+    else if (p <= bitset_limit) {
+        long long m = 0;
+        for (const Vertex& v : P)  ind[v.get_id()] = 1;
+        for (const Vertex& v : P)
+            for (int w : A.neighbors(v.get_id()))
+                m += ind[w];
+        for (const Vertex& v : P)  ind[v.get_id()] = 0;
+        bitset = m >= bitset_density * p * (p - 1);
+    }
+
+    if (bitset) {
+        #pragma omp atomic
+        bitset_roots++;
+    }
+    else {
+        #pragma omp atomic
+        sparse_roots++;
+    }
+    return bitset;
+}
+
+template <class Adjacency>
+void pmcx_maxclique::search_root(
+        const Adjacency& A,
+        const Vertex& root,
+        vector<Vertex> &P,
+        vector<short>& ind,
+        vector<int>& C,
+        vector<int>& C_max,
+        vector< vector<int> >& colors,
+        bitset_solver& solver,
+        const bool_vector& pruned,
+        const vector<int>* bound,
+        int& mc) {
+
+    P.push_back(root);
+    for (int w : A.neighbors(root.get_id()))
+        if (!pruned[w])
+            if ((*bound)[w] > mc)
+                P.push_back(Vertex(w, A.degree(w))); /// local
+    sort_by_degree(P, 1, *degree);
+
+    if (P.size() > mc) {
+        // small or dense neighborhoods: cores, coloring and branching over a local bit matrix
+        if (use_bitset(A, P, ind)) {
+            solver.solve(A, P, *bound, pruned, mc, not_reached_ub,
+                    [&](const vector<int>& C_local) { record_clique(C_local, C_max, mc); });
+            return;
+        }
+        neigh_cores_bound(A,P,ind,mc);
+        if (P.size() > mc && P[0].get_bound() >= mc) {
+            neigh_coloring_bound(A,P,ind,C,colors,mc);
+            if (P.back().get_bound() > mc) {
+                // sorted ids of P, branch() intersects them with the neighbor lists
+                vector<int> Ps(P.size());
+                for (int k = 0; k < P.size(); k++)  Ps[k] = P[k].get_id();
+                std::sort(Ps.begin(), Ps.end());
+                branch(A, P, Ps, ind, C, C_max, colors, pruned, bound, mc);
+            }
+        }
+    }
+}
+
+template <class Adjacency>
 void pmcx_maxclique::branch(
-        vector<long long>& vs,
-        vector<int>& es,
+        const Adjacency& A,
         vector<Vertex> &P,
+        vector<int>& Ps,
         vector<short>& ind,
         vector<int>& C,
         vector<int>& C_max,
         vector< vector<int> >& colors,
         const bool_vector& pruned,
+        const vector<int>* bound,
         int& mc) {
 
     // stop early if ub is reached
@@ -126,22 +238,32 @@ void pmcx_maxclique::branch(
                 int v = P.back().get_id();   C.push_back(v);
 
                 vector<Vertex> R;   R.reserve(P.size());
-                for (long long j = vs[v]; j < vs[v + 1]; j++)   ind[es[j]] = 1;
+                // common neighbors by a sorted intersection, only they are marked
+                vector<int> Rs(Ps.size());
+                Rs.resize(common_neighbors(A, v, Ps, Rs.data()));
+                for (int w : Rs)   ind[w] = 1;
 
                 // intersection of N(v) and P - {v}
                 for (int k = 0; k < P.size() - 1; k++)
                     if (ind[P[k].get_id()])
                         if (!pruned[P[k].get_id()])
-                            if ((*bound)[P[k].get_id()] > mc)
+                            if ((*bound)[P[k].get_id()] > mc) {
                                 R.push_back(P[k]);
+                                ind[P[k].get_id()] = 2;
+                            }
 
-                for (long long j = vs[v]; j < vs[v + 1]; j++)  ind[es[j]] = 0;
-
+                // keep the sorted ids of R
+                int r = 0;
+                for (int w : Rs) {
+                    if (ind[w] == 2)  Rs[r++] = w;
+                    ind[w] = 0;
+                }
+                Rs.resize(r);
 
                 if (R.size() > 0) {
                     // color graph induced by R and sort for O(1)
-                    neigh_coloring_bound(vs, es, R, ind, C, colors, mc);
-                    branch(vs, es, R, ind, C, C_max, colors, pruned, mc);
+                    neigh_coloring_bound(A, R, ind, C, colors, mc);
+                    branch(A, R, Rs, ind, C, C_max, colors, pruned, bound, mc);
                 }
                 else if (C.size() > mc) {
                     // obtain lock
@@ -162,11 +284,74 @@ void pmcx_maxclique::branch(
                 C.pop_back();
             }
             else return;
+            Ps.erase(std::lower_bound(Ps.begin(), Ps.end(), P.back().get_id()));
             P.pop_back();
         }
     }
 }
 
+/**
+ * Sparse search over the compressed neighbor lists (pmc_graph::compress_edges)
+ *   + the lists are encoded after the initial pruning and the plain lists freed
+ *   + all threads share the encoded lists, pruned vertices are skipped through
+ *     the pruned flags instead of rebuilding a reduced graph per thread
+ */
+int pmcx_maxclique::search_compressed(pmc_graph& G, vector<int>& sol) {
+
+    degree = G.get_degree();
+    bool_vector pruned(G.num_vertices());
+    int mc = lb, i = 0, u = 0;
+
+    // initial pruning
+    int lb_idx = G.initial_pruning(G, pruned, lb);
+    G.compress_edges(true);
+    const compressed_csr& A = *G.get_compressed_edges();
+
+    // set to worst case bound of cores/coloring
+    vector<Vertex> P, T;
+    P.reserve(G.get_max_degree()+1);
+    T.reserve(G.get_max_degree()+1);
+
+    vector<int> C, C_max;
+    C.reserve(G.get_max_degree()+1);
+    C_max.reserve(G.get_max_degree()+1);
+
+    // see search()
+    vector< vector<int> > colors(G.get_max_core()+3);
+    for (int i = 0; i < G.get_max_core()+1; i++)  colors[i].reserve(G.get_max_core()+1);
+
+    // order verts for our search routine
+    vector<Vertex> V;
+    V.reserve(G.num_vertices());
+    G.order_vertices(V,G,lb_idx,lb,vertex_ordering,decr_order);
+    DEBUG_PRINTF("|V| = %i\n", V.size());
+
+    vector<short> ind(G.num_vertices(),0);
+    bitset_solver solver(G.num_vertices());
+
+    #pragma omp parallel for schedule(dynamic) shared(pruned, G, A, T, V, mc, C_max) \
+        firstprivate(colors,ind,solver) private(u, P, C) num_threads(num_threads)
+    for (i = 0; i < (long long)V.size() - max(mc-1, 0); ++i) {
+        if (not_reached_ub) {
+            if (G.time_left(C_max,sec,time_limit,time_expired_msg)) {
+
+                u = V[i].get_id();
+                if ((*bound)[u] > mc) {
+                    search_root(A, V[i], P, ind, C, C_max, colors, solver, pruned, bound, mc);
+                    P = T;
+                }
+                pruned[u] = true;
+            }
+        }
+    }
+
+    sol.resize(mc);
+    for (int i = 0; i < C_max.size(); i++)  sol[i] = C_max[i];
+    print_root_kernels("neighbor lists");
+    G.print_break();
+    return sol.size();
+}
+
 /**
  * Dense graphs: we use ADJ matrix + CSC Representation
  * ADJ:	  O(1) edge lookups
@@ -175,8 +360,12 @@ void pmcx_maxclique::branch(
  */
 int pmcx_maxclique::search_dense(pmc_graph& G, vector<int>& sol) {
 
-    auto adj = G.adj;
+    // shared by all threads and cleared in place as roots are pruned, bit_matrix::reset is atomic.
+    // A search leaves the matrix empty, the next one builds it again
+    if (G.adj.empty())  G.create_adj();
+    bit_matrix& adj = G.adj;
 
+    degree = G.get_degree();
     bool_vector pruned(G.num_vertices());
     int mc = lb, i = 0, u = 0;
 
@@ -206,49 +395,63 @@ int pmcx_maxclique::search_dense(pmc_graph& G, vector<int>& sol) {
     DEBUG_PRINTF("|V| = %i\n", V.size());
 
     vector<short> ind(G.num_vertices(),0);
-    vector<int> es = G.get_edges_array();
-    vector<long long> vs = G.get_vertices_array();
+    bitset_solver solver(G.num_vertices());
+    // per-thread copies borrow G's arrays until a thread reduces its graph
+    csr_array<int> es = G.edges_view();
+    csr_array<long long> vs = G.vertices_view();
 
     vector<double> induce_time(num_threads,get_time());
     for (int t = 0; t < num_threads; ++t)  induce_time[t] = induce_time[t] + t/4;
 
+    // k-cores of the unpruned vertices, refreshed in the background as threads reduce their graphs
+    bound_refresh refresh(G, pruned);
 
-    #pragma omp parallel for schedule(dynamic) shared(pruned, G, adj, T, V, mc, C_max, induce_time) \
-        firstprivate(colors,ind,vs,es) private(u, P, C) num_threads(num_threads)
-    for (i = 0; i < (V.size()) - (mc-1); ++i) {
+    #pragma omp parallel for schedule(dynamic) shared(pruned, G, adj, T, V, mc, C_max, induce_time, refresh) \
+        firstprivate(colors,ind,solver,vs,es) private(u, P, C) num_threads(num_threads)
+    for (i = 0; i < (long long)V.size() - max(mc-1, 0); ++i) {
         DEBUG_PRINTF("DEBUG current mc: %i\n", mc);
         if (not_reached_ub) {
             if (G.time_left(C_max,sec,time_limit,time_expired_msg)) {
 
                 u = V[i].get_id();
+                // bounds for this root, refreshes publish a new array and leave this one intact
+                bound_refresh::snapshot bounds = refresh.acquire();
+                const vector<int>* bound = bounds.get();
                 if ((*bound)[u] > mc) {
                     P.push_back(V[i]);
                     for (long long j = vs[u]; j < vs[u + 1]; ++j)
                         if (!pruned[es[j]])
                             if ((*bound)[es[j]] > mc)
                             	P.push_back(Vertex(es[j], (vs[es[j]+1] - vs[es[j]]) )); /// local
+                    sort_by_degree(P, 1, *degree);
 
-                    if (P.size() > mc) {
+                    if (P.size() > mc && use_bitset(csr_adjacency(vs, es), P, ind)) {
+                        solver.solve(csr_adjacency(vs, es), P, *bound, pruned, mc, not_reached_ub,
+                                [&](const vector<int>& C_local) { record_clique(C_local, C_max, mc); });
+                    }
+                    else if (P.size() > mc) {
                         // neighborhood core ordering and pruning
                         neigh_cores_bound(vs,es,P,ind,mc);
                         if (P.size() > mc && P[0].get_bound() >= mc) {
                             neigh_coloring_dense(P,C,colors,mc, adj);
                             if (P.back().get_bound() > mc) {
-                                branch_dense(vs,es,P, ind, C, C_max, colors, pruned, mc, adj);
+                                branch_dense(vs,es,P, ind, C, C_max, colors, pruned, bound, mc, adj);
                             }
                         }
                     }
                     P = T;
                 }
                 pruned[u] = true;
+                refresh.prune(u);
                 for (long long j = vs[u]; j < vs[u + 1]; j++) {
-                    adj[u][es[j]] = false;
-                    adj[es[j]][u] = false;
+                    adj.reset(u, es[j]);
+                    adj.reset(es[j], u);
                 }
 
                 // dynamically reduce graph in a thread-safe manner
                 if ((get_time() - induce_time[omp_get_thread_num()]) > wait_time) {
                     G.reduce_graph( vs, es, pruned, G);
+                    refresh.request();
                     G.graph_stats(G, mc, i+lb_idx, sec);
                     induce_time[omp_get_thread_num()] = get_time();
                 }
@@ -256,24 +459,29 @@ int pmcx_maxclique::search_dense(pmc_graph& G, vector<int>& sol) {
         }
     }
 
+    refresh.stop();
+    // the pruned vertices were cleared from it, it no longer matches G
+    adj = bit_matrix();
     sol.resize(mc);
     for (int i = 0; i < C_max.size(); i++)  sol[i] = C_max[i];
+    print_root_kernels("adjacency matrix");
     G.print_break();
     return sol.size();
 }
 
 
 void pmcx_maxclique::branch_dense(
-        vector<long long>& vs,
-        vector<int>& es,
+        const csr_array<long long>& vs,
+        const csr_array<int>& es,
         vector<Vertex> &P,
         vector<short>& ind,
         vector<int>& C,
         vector<int>& C_max,
         vector< vector<int> >& colors,
         const bool_vector& pruned,
+        const vector<int>* bound,
         int& mc,
-        const std::vector<bool_vector>& adj) {
+        const bit_matrix& adj) {
 
     // stop early if ub is reached
     if (not_reached_ub) {
@@ -285,7 +493,7 @@ void pmcx_maxclique::branch_dense(
 
                 for (int k = 0; k < P.size() - 1; k++)
                     // indicates neighbor AND pruned, since threads dynamically update it
-                    if (adj[v][P[k].get_id()])
+                    if (adj.test(v, P[k].get_id()))
                         if ((*bound)[P[k].get_id()] > mc)
                             R.push_back(P[k]);
 
@@ -293,7 +501,7 @@ void pmcx_maxclique::branch_dense(
                 if (R.size() > 0) {
                     // color graph induced by R and sort for O(1)
                     neigh_coloring_dense(R, C, colors, mc, adj);
-                    branch_dense(vs, es, R, ind, C, C_max, colors, pruned, mc, adj);
+                    branch_dense(vs, es, R, ind, C, C_max, colors, pruned, bound, mc, adj);
                 }
                 else if (C.size() > mc) {
                     // obtain lock
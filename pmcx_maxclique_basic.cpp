@@ -18,6 +18,7 @@
  */
 
 #include "pmc/pmcx_maxclique_basic.h"
+#include "pmc/pmc_bound_refresh.h"
 #include "pmc/pmc_neigh_coloring.h"
 
 #include <cstring>
@@ -26,6 +27,14 @@ using namespace std;
 using namespace pmc;
 
 int pmcx_maxclique_basic::search(pmc_graph& G, vector<int>& sol) {
+    // the offset width is picked from the number of stored edges
+    if (G.fits_narrow_offsets())
+        return search_sparse<uint32_t>(G, sol);
+    return search_sparse<long long>(G, sol);
+}
+
+template <class Offset>
+int pmcx_maxclique_basic::search_sparse(pmc_graph& G, vector<int>& sol) {
 
     degree = G.get_degree();
     bool_vector pruned(G.num_vertices());
@@ -54,44 +63,57 @@ int pmcx_maxclique_basic::search(pmc_graph& G, vector<int>& sol) {
     DEBUG_PRINTF("|V| = %i\n", V.size());
 
     vector<short> ind(G.num_vertices(),0);
-    vector<int> es = G.get_edges_array();
-    vector<long long> vs = G.get_vertices_array();
+    // per-thread copies borrow these arrays until a thread reduces its graph
+    csr_array<int> es = G.edges_view();
+    csr_array<Offset> offsets;
+    G.offsets(offsets);
+    csr_array<Offset> vs = offsets.view();
 
     vector<double> induce_time(num_threads,get_time());
     for (int t = 0; t < num_threads; ++t)  induce_time[t] = induce_time[t] + t/4;
 
-    #pragma omp parallel for schedule(dynamic) shared(pruned, G, T, V, mc, C_max, induce_time) \
+    // k-cores of the unpruned vertices, refreshed in the background as threads reduce their graphs
+    bound_refresh refresh(G, pruned);
+
+    #pragma omp parallel for schedule(dynamic) shared(pruned, G, T, V, mc, C_max, induce_time, refresh) \
         firstprivate(colors,ind,vs,es) private(u, P, C) num_threads(num_threads)
-    for (i = 0; i < (V.size()) - (mc-1); ++i) {
+    for (i = 0; i < (long long)V.size() - max(mc-1, 0); ++i) {
         if (G.time_left(C_max,sec,time_limit,time_expired_msg)) {
 
             u = V[i].get_id();
+            // bounds for this root, refreshes publish a new array and leave this one intact
+            bound_refresh::snapshot bounds = refresh.acquire();
+            const vector<int>* bound = bounds.get();
             if ((*bound)[u] > mc) {
                 P.push_back(V[i]);
-                for (long long j = vs[u]; j < vs[u + 1]; ++j)
+                for (Offset j = vs[u]; j < vs[u + 1]; ++j)
                     if (!pruned[es[j]])
                         if ((*bound)[es[j]] > mc)
                             P.push_back(Vertex(es[j], (*degree)[es[j]]));
+                sort_by_degree(P, 1, *degree);
 
                 if (P.size() > mc) {
-                    neigh_coloring_bound(vs,es,P,ind,C,colors,mc);
+                    neigh_coloring_bound(basic_csr_adjacency<Offset>(vs, es), P, ind, C, colors, mc);
                     if (P.back().get_bound() > mc) {
-                        branch(vs,es,P, ind, C, C_max, colors, pruned, mc);
+                        branch(vs,es,P, ind, C, C_max, colors, pruned, bound, mc);
                     }
                 }
                 P = T;
             }
             pruned[u] = true;
+            refresh.prune(u);
 
             // dynamically reduce graph in a thread-safe manner
             if ((get_time() - induce_time[omp_get_thread_num()]) > wait_time) {
                 G.reduce_graph( vs, es, pruned, G);
+                refresh.request();
                 G.graph_stats(G, mc, i+lb_idx, sec);
                 induce_time[omp_get_thread_num()] = get_time();
             }
         }
     }
 
+    refresh.stop();
     sol.resize(mc);
     for (int i = 0; i < C_max.size(); i++)  sol[i] = C_max[i];
     G.print_break();
@@ -101,15 +123,17 @@ int pmcx_maxclique_basic::search(pmc_graph& G, vector<int>& sol) {
 
 
 
+template <class Offset>
 void pmcx_maxclique_basic::branch(
-        vector<long long>& vs,
-        vector<int>& es,
+        const csr_array<Offset>& vs,
+        const csr_array<int>& es,
         vector<Vertex> &P,
         vector<short>& ind,
         vector<int>& C,
         vector<int>& C_max,
         vector< vector<int> >& colors,
         const bool_vector& pruned,
+        const vector<int>* bound,
         int& mc) {
 
     // stop early if ub is reached
@@ -120,7 +144,7 @@ void pmcx_maxclique_basic::branch(
                 int v = P.back().get_id();   C.push_back(v);
 
                 vector<Vertex> R;   R.reserve(P.size());
-                for (long long j = vs[v]; j < vs[v + 1]; j++)   ind[es[j]] = 1;
+                for (Offset j = vs[v]; j < vs[v + 1]; j++)   ind[es[j]] = 1;
 
                 // intersection of N(v) and P - {v}
                 for (int k = 0; k < P.size() - 1; k++)
@@ -129,14 +153,14 @@ void pmcx_maxclique_basic::branch(
                             if ((*bound)[P[k].get_id()] > mc)
                                 R.push_back(P[k]);
 
-                for (long long j = vs[v]; j < vs[v + 1]; j++)  ind[es[j]] = 0;
+                for (Offset j = vs[v]; j < vs[v + 1]; j++)  ind[es[j]] = 0;
 
 
                 if (R.size() > 0) {
                     // color graph induced by R and sort for O(1) bound check
-                    neigh_coloring_bound(vs, es, R, ind, C, colors, mc);
+                    neigh_coloring_bound(basic_csr_adjacency<Offset>(vs, es), R, ind, C, colors, mc);
                     // search reordered R
-                    branch(vs, es, R, ind, C, C_max, colors, pruned, mc);
+                    branch(vs, es, R, ind, C, C_max, colors, pruned, bound, mc);
                 }
                 else if (C.size() > mc) {
                     // obtain lock
@@ -178,7 +202,9 @@ void pmcx_maxclique_basic::branch(
 int pmcx_maxclique_basic::search_dense(pmc_graph& G, vector<int>& sol) {
 
     degree = G.get_degree();
-    auto adj = G.adj;
+    // G.adj itself, not a copy (see pmcx_maxclique::search_dense)
+    if (G.adj.empty())  G.create_adj();
+    bit_matrix& adj = G.adj;
 
     bool_vector pruned(G.num_vertices());
 
@@ -207,49 +233,60 @@ int pmcx_maxclique_basic::search_dense(pmc_graph& G, vector<int>& sol) {
     DEBUG_PRINTF("|V| = %u\n", V.size());
 
     vector<short> ind(G.num_vertices(),0);
-    vector<int> es = G.get_edges_array();
-    vector<long long> vs = G.get_vertices_array();
+    // per-thread copies borrow G's arrays until a thread reduces its graph
+    csr_array<int> es = G.edges_view();
+    csr_array<long long> vs = G.vertices_view();
 
     vector<double> induce_time(num_threads,get_time());
     for (int t = 0; t < num_threads; ++t)  induce_time[t] = induce_time[t] + t/4;
 
+    // k-cores of the unpruned vertices, refreshed in the background as threads reduce their graphs
+    bound_refresh refresh(G, pruned);
 
-    #pragma omp parallel for schedule(dynamic) shared(pruned, G, adj, T, V, mc, C_max, induce_time) \
+    #pragma omp parallel for schedule(dynamic) shared(pruned, G, adj, T, V, mc, C_max, induce_time, refresh) \
         firstprivate(colors,ind,vs,es) private(u, P, C) num_threads(num_threads)
-    for (i = 0; i < (V.size()) - (mc-1); ++i) {
+    for (i = 0; i < (long long)V.size() - max(mc-1, 0); ++i) {
         if (G.time_left(C_max,sec,time_limit,time_expired_msg)) {
 
             u = V[i].get_id();
+            // bounds for this root, refreshes publish a new array and leave this one intact
+            bound_refresh::snapshot bounds = refresh.acquire();
+            const vector<int>* bound = bounds.get();
             if ((*bound)[u] > mc) {
                 P.push_back(V[i]);
                 for (long long j = vs[u]; j < vs[u + 1]; ++j)
                     if (!pruned[es[j]])
                         if ((*bound)[es[j]] > mc)
                             P.push_back(Vertex(es[j], (*degree)[es[j]]));
+                sort_by_degree(P, 1, *degree);
 
                 if (P.size() > mc) {
                     neigh_coloring_dense(P,C,colors,mc, adj);
                     if (P.back().get_bound() > mc) {
-                        branch_dense(vs,es,P, ind, C, C_max, colors, pruned, mc, adj);
+                        branch_dense(vs,es,P, ind, C, C_max, colors, pruned, bound, mc, adj);
                     }
                 }
                 P = T;
             }
             pruned[u] = true;
+            refresh.prune(u);
             for (long long j = vs[u]; j < vs[u + 1]; j++) {
-                adj[u][es[j]] = false;
-                adj[es[j]][u] = false;
+                adj.reset(u, es[j]);
+                adj.reset(es[j], u);
             }
 
             // dynamically reduce graph in a thread-safe manner
             if ((get_time() - induce_time[omp_get_thread_num()]) > wait_time) {
                 G.reduce_graph( vs, es, pruned, G);
+                refresh.request();
                 G.graph_stats(G, mc, i+lb_idx, sec);
                 induce_time[omp_get_thread_num()] = get_time();
             }
         }
     }
 
+    refresh.stop();
+    adj = bit_matrix();
     sol.resize(mc);
     for (int i = 0; i < C_max.size(); i++)  sol[i] = C_max[i];
     G.print_break();
@@ -260,16 +297,17 @@ int pmcx_maxclique_basic::search_dense(pmc_graph& G, vector<int>& sol) {
 
 
 void pmcx_maxclique_basic::branch_dense(
-        vector<long long>& vs,
-        vector<int>& es,
+        const csr_array<long long>& vs,
+        const csr_array<int>& es,
         vector<Vertex> &P,
         vector<short>& ind,
         vector<int>& C,
         vector<int>& C_max,
         vector< vector<int> >& colors,
         bool_vector& pruned,
+        const vector<int>* bound,
         int& mc,
-        std::vector<bool_vector>& adj) {
+        bit_matrix& adj) {
 
     // stop early if ub is reached
     if (not_reached_ub) {
@@ -281,14 +319,14 @@ void pmcx_maxclique_basic::branch_dense(
 
                 for (int k = 0; k < P.size() - 1; k++)
                     // indicates neighbor AND pruned, since threads dynamically update it
-                    if (adj[v][P[k].get_id()])
+                    if (adj.test(v, P[k].get_id()))
                         if ((*bound)[P[k].get_id()] > mc)
                             R.push_back(P[k]);
 
                 if (R.size() > 0) {
                     // color graph induced by R and sort for O(1)
                     neigh_coloring_dense(R, C, colors, mc, adj);
-                    branch_dense(vs, es, R, ind, C, C_max, colors, pruned, mc, adj);
+                    branch_dense(vs, es, R, ind, C, C_max, colors, pruned, bound, mc, adj);
                 }
                 else if (C.size() > mc) {
                     // obtain lock